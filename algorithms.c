@@ -4,6 +4,9 @@
  */
 
 #include "algorithms.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "util.h"
 
 const double ALPHA = 0.001; // Used for simulated annealing algorithm
 
@@ -47,10 +50,12 @@ Point *solveDFS(int N, int maxtime) {
 
     // Push root chessboard with no queens in stack (start state)
     push(queenPositions, 0, s);
+    TRACE_EVENT(TRACE_PUSH, 0, -1);
 
     int queenAmount, // Popped stack's queen amount
         threats,     // Amount of threats found
         i, foundSolution = 0, timeExpired = 0;
+    long long nodesExpanded = 0; // Popped states, published as progress
     Point queenMove; // Next move
     clock_t timeStart = clock(), timeElapsed; // Time counter
 
@@ -58,6 +63,9 @@ Point *solveDFS(int N, int maxtime) {
     while(!isEmpty(s) && !timeExpired) {
         // Get top
         pop(s, &queenPositions, &queenAmount);
+        TRACE_EVENT(TRACE_POP, queenAmount, s->size);
+        PUBLISH_PROGRESS(nodes, ++nodesExpanded);
+        PUBLISH_PROGRESS(depth, s->size);
 
         // Check time interval
         timeElapsed = clock() - timeStart;
@@ -101,6 +109,7 @@ Point *solveDFS(int N, int maxtime) {
                 // Else push to stack
                 else {
                     push(queenPositions, queenAmount + 1, s);
+                    TRACE_EVENT(TRACE_PUSH, queenAmount + 1, i);
                 }
             }
         }
@@ -133,19 +142,421 @@ Point *solveDFS(int N, int maxtime) {
     }
 }
 
-Point *solveHill(int N, int maxtime, int seed, int *restartsCount, int *movesMade) {
+const int GREEDY_TRIES = 8; // Random columns tried per row by the greedy initial permutation
+
+/**
+ * @brief Helper function to allocate a permutation state for a single solve.
+ * @return Returns EXIT_FAILURE if memory can't be allocated else EXIT_SUCCESS.
+ */
+static int initPermutation(Permutation *p, int N, int seed) {
+    if (N <= 0) {
+        return EXIT_FAILURE;
+    }
+    p->N = N;
+    p->rng = seedRandom(seed);
+    p->publish = 1;
+    p->colOf = malloc(N * sizeof(int));
+    p->diags = malloc((2 * N - 1) * sizeof(int));
+    p->antis = malloc((2 * N - 1) * sizeof(int));
+    p->rows = malloc(N * sizeof(int));
+    if (p->colOf == NULL || p->diags == NULL || p->antis == NULL || p->rows == NULL) {
+        free(p->colOf);
+        free(p->diags);
+        free(p->antis);
+        free(p->rows);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Helper function to free a permutation state and return its queens as points.
+ */
+static Point *permutationPoints(Permutation *p) {
+    Point *queenPositions = malloc(p->N * sizeof(Point));
+    int i;
+
+    for (i = 0; queenPositions != NULL && i < p->N; i++) {
+        queenPositions[i].x = i;
+        queenPositions[i].y = p->colOf[i];
+    }
+    free(p->colOf);
+    free(p->diags);
+    free(p->antis);
+    free(p->rows);
+
+    return queenPositions;
+}
+
+/**
+ * @brief Helper function to add (delta 1) or remove (delta -1) a queen on its diagonals.
+ * @return Returns the change in threats.
+ */
+static int placePermutation(Permutation *p, int row, int col, int delta) {
+    int *diag = &p->diags[row + col], *anti = &p->antis[row - col + p->N - 1];
+
+    if (delta > 0) {
+        return (*diag)++ + (*anti)++;
+    }
+    return -(--(*diag) + --(*anti));
+}
+
+/**
+ * @brief Helper function to swap the columns of the queens of rows a and b.
+ *
+ * Only the four diagonals touched are updated, swapping again undoes it.
+ *
+ * @return Returns the change in threats.
+ */
+static int swapPermutation(Permutation *p, int a, int b) {
+    int colA = p->colOf[a], colB = p->colOf[b], change;
+
+    change = placePermutation(p, a, colA, -1) + placePermutation(p, b, colB, -1);
+    change += placePermutation(p, a, colB, 1) + placePermutation(p, b, colA, 1);
+    p->colOf[a] = colB;
+    p->colOf[b] = colA;
+    p->threats += change;
+
+    return change;
+}
+
+/**
+ * @brief Helper function to check if the queen of a row is threatened.
+ */
+static int isThreatenedPermutation(Permutation *p, int row) {
+    int col = p->colOf[row];
+    return p->diags[row + col] > 1 || p->antis[row - col + p->N - 1] > 1;
+}
+
+/**
+ * @brief Helper function to make a greedy diagonal-aware initial permutation.
+ *
+ * Row by row, the columns not used yet are kept at the tail of colOf. Each
+ * row tries up to GREEDY_TRIES of them at random and takes the first that is
+ * on no used diagonal, or else the least threatened one tried.
+ */
+static void greedyPermutation(Permutation *p) {
+    int N = p->N, row, try, k, pick, threats, bestThreats, tmp;
+
+    for (k = 0; k < N; k++) {
+        p->colOf[k] = k;
+    }
+    for (k = 0; k < 2 * N - 1; k++) {
+        p->diags[k] = 0;
+        p->antis[k] = 0;
+    }
+    p->threats = 0;
+
+    for (row = 0; row < N; row++) {
+        pick = row;
+        bestThreats = INT_MAX;
+        for (try = 0; try < GREEDY_TRIES && bestThreats > 0; try++) {
+            k = row + nextRandom(&p->rng) % (N - row);
+            threats = p->diags[row + p->colOf[k]] + p->antis[row - p->colOf[k] + N - 1];
+            if (threats < bestThreats) {
+                bestThreats = threats;
+                pick = k;
+            }
+        }
+        tmp = p->colOf[row];
+        p->colOf[row] = p->colOf[pick];
+        p->colOf[pick] = tmp;
+        p->threats += placePermutation(p, row, p->colOf[row], 1);
+    }
+}
+
+/**
+ * @brief Helper function to shuffle the columns of the threatened queens among their rows.
+ * @return Returns the amount of queens shuffled.
+ */
+static int perturbPermutation(Permutation *p) {
+    int threatened = 0, k, j;
+
+    for (k = 0; k < p->N; k++) {
+        if (isThreatenedPermutation(p, k)) {
+            p->rows[threatened++] = k;
+        }
+    }
+    // Fisher-Yates shuffle of their columns
+    for (k = threatened - 1; k > 0; k--) {
+        j = nextRandom(&p->rng) % (k + 1);
+        if (j != k) {
+            swapPermutation(p, p->rows[j], p->rows[k]);
+        }
+    }
+
+    return threatened;
+}
+
+/**
+ * @brief Helper function to move every threatened queen to a random column.
+ *
+ * threatened is scratch space of N ints owned by the caller, so partial
+ * restarts don't allocate.
+ *
+ * @return Returns the amount of queens moved.
+ */
+static int perturbQueens(Point *queenPositions, int N, int *threatened) {
+    int i, j, moved = 0;
+
+    for (i = 0; i < N; i++) {
+        threatened[i] = 0;
+    }
+    // Mark them all before moving any
+    for (i = 0; i < N; i++) {
+        for (j = i + 1; j < N; j++) {
+            if (queenPositions[i].y == queenPositions[j].y
+                || abs(i - j) == abs(queenPositions[i].y - queenPositions[j].y)) {
+                threatened[i] = threatened[j] = 1;
+            }
+        }
+    }
+    for (i = 0; i < N; i++) {
+        if (threatened[i]) {
+            queenPositions[i].y = rand() % N;
+            moved++;
+        }
+    }
+
+    return moved;
+}
+
+/**
+ * @brief Helper function to get term r (from 1) of the Luby sequence 1, 1, 2, 1, 1, 2, 4, ...
+ */
+static long long lubyTerm(long long r) {
+    int k;
+
+    for (;;) {
+        for (k = 1; (1LL << k) - 1 < r; k++)
+            ;
+        if ((1LL << k) - 1 == r) {
+            return 1LL << (k - 1);
+        }
+        r -= (1LL << (k - 1)) - 1; // Repeat of an earlier part of the sequence
+    }
+}
+
+/**
+ * @brief Helper function to check if a policy cuts run (from 0) after its steps.
+ */
+static int cutoffReached(const RestartPolicy *policy, int run, long long runSteps, long long stallSteps) {
+    if (policy == NULL) {
+        return 0;
+    }
+    switch (policy->kind) {
+        case RESTART_LUBY:
+            return runSteps >= policy->unit * lubyTerm(run + 1);
+        case RESTART_GEOMETRIC:
+            return runSteps >= policy->unit * pow(policy->factor, run);
+        case RESTART_STALL:
+            return stallSteps >= policy->unit;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * @brief Helper function to add the steps of a finished run to the run-length distribution.
+ */
+static void recordRun(RunLengths *runLengths, long long steps) {
+    int bucket = 0;
+
+    if (runLengths == NULL) {
+        return;
+    }
+    while (bucket < RUN_BUCKETS - 1 && (2LL << bucket) <= steps) {
+        bucket++;
+    }
+    runLengths->runs++;
+    runLengths->steps += steps;
+    runLengths->buckets[bucket]++;
+    runLengths->lastRun = steps;
+}
+
+int hillPermutation(Permutation *p, const struct timespec *deadline, const RestartPolicy *policy,
+                    RunLengths *runLengths, int *restartsCount, int *movesMade) {
+    int N = p->N, a, b, change, bestChange, newA = 0, newB = 0, bestThreats = INT_MAX, runBest = 0;
+    long long runSteps = 0, stallSteps = 0; // Steps of the run, and since its best threats were lowered
+
+    *movesMade = 0;
+    *restartsCount = -1; // First pass from label doesn't count (will turn to 0)
+    if (runLengths != NULL) {
+        memset(runLengths, 0, sizeof(RunLengths));
+    }
+
+    restart_hill_permutation:
+    if (*restartsCount >= 0) {
+        recordRun(runLengths, runSteps);
+    }
+    (*restartsCount)++;
+    greedyPermutation(p);
+    *movesMade = *movesMade + N; // Placed N queens
+    if (p->publish) {
+        PUBLISH_PROGRESS(restarts, *restartsCount);
+        PUBLISH_PROGRESS(moves, *movesMade);
+    }
+    runSteps = stallSteps = 0;
+    runBest = p->threats;
+    TRACE_EVENT(TRACE_RESTART, *restartsCount, p->threats);
+
+    move_search_hill_permutation:
+    if (p->threats < bestThreats) {
+        bestThreats = p->threats;
+        if (p->publish) {
+            PUBLISH_PROGRESS(bestThreats, bestThreats);
+        }
+    }
+    if (p->threats == 0) {
+        recordRun(runLengths, runSteps);
+        return 1;
+    }
+    if (cutoffReached(policy, *restartsCount, runSteps, stallSteps)) {
+        goto restart_hill_permutation;
+    }
+    runSteps++;
+
+    // Find the swap that lowers the threats the most
+    // One of the rows must have a threatened queen, or the swap can't help
+    bestChange = 0;
+    for (a = 0; a < N; a++) {
+        if (!isThreatenedPermutation(p, a)) {
+            continue;
+        }
+        // Check time interval
+        if (isExpired(deadline)) {
+            return 0; // Terminate
+        }
+        for (b = 0; b < N; b++) {
+            if (b == a) {
+                continue;
+            }
+            change = swapPermutation(p, a, b);
+            swapPermutation(p, a, b); // Undo
+            if (change < bestChange) {
+                bestChange = change;
+                newA = a;
+                newB = b;
+            }
+        }
+    }
+
+    // If a swap was found that reduces the threats
+    if (bestChange < 0) {
+        swapPermutation(p, newA, newB);
+        *movesMade = *movesMade + 2; // Two queens moved
+        TRACE_EVENT(TRACE_ACCEPT, newA, p->threats);
+    }
+    else if (policy != NULL && policy->partial) {
+        change = perturbPermutation(p); // Partial restart
+        *movesMade = *movesMade + change;
+        TRACE_EVENT(TRACE_PARTIAL, change, p->threats);
+    }
+    else {
+        goto restart_hill_permutation; // Restart search
+    }
+    if (p->publish) {
+        PUBLISH_PROGRESS(moves, *movesMade);
+    }
+    if (p->threats < runBest) {
+        runBest = p->threats;
+        stallSteps = 0;
+    }
+    else {
+        stallSteps++;
+    }
+    goto move_search_hill_permutation;
+}
+
+int annPermutation(Permutation *p, const struct timespec *deadline, int *movesMade) {
+    int N = p->N, a, b, tries, change, bestThreats = INT_MAX;
+    long long steps = 0;
+
+    greedyPermutation(p);
+    *movesMade = N; // Placed N queens
+    TRACE_EVENT(TRACE_RESTART, 0, p->threats);
+
+    for (;;) {
+        if (p->threats < bestThreats) {
+            bestThreats = p->threats;
+            if (p->publish) {
+                PUBLISH_PROGRESS(bestThreats, bestThreats);
+            }
+        }
+        if (p->threats == 0) {
+            return 1;
+        }
+
+        // Check time interval, steps are too short to read the clock on each
+        if (++steps % CHECK_STEPS == 0 && isExpired(deadline)) {
+            return 0; // Terminate
+        }
+
+        // Choose a random threatened queen (up to N draws) and another random row
+        a = nextRandom(&p->rng) % N;
+        for (tries = 1; tries < N && !isThreatenedPermutation(p, a); tries++) {
+            a = nextRandom(&p->rng) % N;
+        }
+        b = nextRandom(&p->rng) % (N - 1);
+        if (b >= a) {
+            b++;
+        }
+
+        change = swapPermutation(p, a, b);
+        // If the threats with the swap weren't reduced, keep it with p = a * e^-Dt
+        if (change > 0 && !(nextUniform(&p->rng) <= ALPHA * exp(-change))) {
+            TRACE_EVENT(TRACE_REJECT, a, p->threats);
+            swapPermutation(p, a, b); // Discard swap
+            continue;
+        }
+        TRACE_EVENT(TRACE_ACCEPT, a, p->threats);
+        *movesMade = *movesMade + 2; // Two queens moved
+        if (p->publish) {
+            PUBLISH_PROGRESS(moves, *movesMade);
+        }
+    }
+}
+
+Point *solveHill(int N, int maxtime, int seed, int permutation, const RestartPolicy *policy,
+                 RunLengths *runLengths, int *restartsCount, int *movesMade) {
     srand(seed); // Seed rand()
     *movesMade = 0;
     *restartsCount = -1; // First pass from label doesn't count (will turn to 0)
+    if (runLengths != NULL) {
+        memset(runLengths, 0, sizeof(RunLengths));
+    }
+    if (permutation) {
+        Permutation p;
+        struct timespec start, deadline;
+        if (initPermutation(&p, N, seed) == EXIT_FAILURE) {
+            return NULL;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        deadline = deadlineAfter(&start, maxtime * 1000LL);
+        if (hillPermutation(&p, &deadline, policy, runLengths, restartsCount, movesMade)) {
+            return permutationPoints(&p);
+        }
+        free(permutationPoints(&p));
+        return NULL;
+    }
     // Point array of placed queens' positions (x , y) at current state
     Point *curQueenPositions = malloc(N * sizeof(Point));
+    // Marks of threatened queens for partial restarts, allocated once per solve
+    int *threatened = malloc(N * sizeof(int));
 
     Point Qi;
-    int i, j;
+    int i, j, bestThreats = INT_MAX; // Lowest threat count reached, published as progress
+    int runBest = 0;                 // Lowest threat count of the current run
+    long long runSteps = 0, stallSteps = 0; // Steps of the run, and since runBest was lowered
     clock_t timeStart = clock(), timeElapsed; // Time counter
 
     restart_hill:
+    if (*restartsCount >= 0) {
+        recordRun(runLengths, runSteps);
+    }
     (*restartsCount)++;
+    PUBLISH_PROGRESS(restarts, *restartsCount);
+    runSteps = stallSteps = 0;
 
     // Place each queen in one row at random column
     for (i = 0; i < N; i++) {
@@ -155,26 +566,42 @@ Point *solveHill(int N, int maxtime, int seed, int *restartsCount, int *movesMad
     }
 
     *movesMade = *movesMade + N; // Placed N queens
+    PUBLISH_PROGRESS(moves, *movesMade);
 
     // Check time interval
     timeElapsed = clock() - timeStart;
     if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= maxtime) {
         free(curQueenPositions);
+        free(threatened);
         return NULL; // Terminate
     }
 
     // Count of threats before a possible move
     int startThreats = countThreats(curQueenPositions, N);
+    TRACE_EVENT(TRACE_RESTART, *restartsCount, startThreats);
+    if (startThreats < bestThreats) {
+        bestThreats = startThreats;
+        PUBLISH_PROGRESS(bestThreats, bestThreats);
+    }
     // Corrent chessboard from the start
     if (startThreats == 0) {
+        recordRun(runLengths, runSteps);
+        free(threatened);
         return curQueenPositions;
     }
+    runBest = startThreats;
 
     // Count of threats when moving a queen to a different column
     // It holds the value of the lowest threat count of all possible moves in a row
     int curThreats = startThreats, newX = 0, newY = 0;
 
     move_search_hill:
+    // Policy cuts the run short
+    if (cutoffReached(policy, *restartsCount, runSteps, stallSteps)) {
+        goto restart_hill;
+    }
+    runSteps++;
+
     // Find a move that minimizes the threats
     // For every queen (row)
     for (i = 0; i < N; i++) {
@@ -184,6 +611,7 @@ Point *solveHill(int N, int maxtime, int seed, int *restartsCount, int *movesMad
             timeElapsed = clock() - timeStart;
             if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= maxtime) {
                 free(curQueenPositions);
+                free(threatened);
                 return NULL; // Terminate
             }
 
@@ -206,29 +634,79 @@ Point *solveHill(int N, int maxtime, int seed, int *restartsCount, int *movesMad
     // If a move was found that reduces the threats
     if (curThreats < startThreats) {
         (*movesMade)++;
+        PUBLISH_PROGRESS(moves, *movesMade);
+        if (curThreats < bestThreats) {
+            bestThreats = curThreats;
+            PUBLISH_PROGRESS(bestThreats, bestThreats);
+        }
         curQueenPositions[newX].y = newY;
+        TRACE_EVENT(TRACE_ACCEPT, newX, curThreats);
         if (curThreats == 0) {
+            recordRun(runLengths, runSteps);
+            free(threatened);
             return curQueenPositions;
         }
         else {
+            if (curThreats < runBest) {
+                runBest = curThreats;
+                stallSteps = 0;
+            }
+            else {
+                stallSteps++;
+            }
             startThreats = curThreats;
             goto move_search_hill; // Threats are not zero, find new move
         }
     }
+    else if (policy != NULL && policy->partial) {
+        // Partial restart, re-randomize only the threatened queens
+        int moved = perturbQueens(curQueenPositions, N, threatened);
+        *movesMade = *movesMade + moved;
+        PUBLISH_PROGRESS(moves, *movesMade);
+        startThreats = curThreats = countThreats(curQueenPositions, N);
+        TRACE_EVENT(TRACE_PARTIAL, moved, startThreats);
+        if (startThreats == 0) {
+            recordRun(runLengths, runSteps);
+            free(threatened);
+            return curQueenPositions;
+        }
+        if (startThreats < runBest) {
+            runBest = startThreats;
+            stallSteps = 0;
+        }
+        else {
+            stallSteps++;
+        }
+        goto move_search_hill;
+    }
     else {
         goto restart_hill; // Restart search
     }
 }
 
-Point *solveAnn(int N, int maxtime, int seed, int *movesMade) {
+Point *solveAnn(int N, int maxtime, int seed, int permutation, int *movesMade) {
     srand(seed); // Seed rand()
     *movesMade = 0;
+    if (permutation) {
+        Permutation p;
+        struct timespec start, deadline;
+        if (initPermutation(&p, N, seed) == EXIT_FAILURE) {
+            return NULL;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        deadline = deadlineAfter(&start, maxtime * 1000LL);
+        if (annPermutation(&p, &deadline, movesMade)) {
+            return permutationPoints(&p);
+        }
+        free(permutationPoints(&p));
+        return NULL;
+    }
 
     // Point array of placed queens' positions (x , y) at current state
     Point *curQueenPositions = malloc(N * sizeof(Point));
 
     Point Qi;
-    int i;
+    int i, bestThreats = INT_MAX; // Lowest threat count reached, published as progress
     clock_t timeStart = clock(), timeElapsed; // Time counter
 
     // Place each queen in one row at random column
@@ -237,6 +715,7 @@ Point *solveAnn(int N, int maxtime, int seed, int *movesMade) {
         Qi.y = rand() % N;
         curQueenPositions[i] = Qi;
     }
+    TRACE_EVENT(TRACE_RESTART, 0, countThreats(curQueenPositions, N));
 
     // Check time interval
     timeElapsed = clock() - timeStart;
@@ -249,6 +728,10 @@ Point *solveAnn(int N, int maxtime, int seed, int *movesMade) {
     new_move_no_move:
     // Count of threats before a possible move
     startThreats = countThreats(curQueenPositions, N);
+    if (startThreats < bestThreats) {
+        bestThreats = startThreats;
+        PUBLISH_PROGRESS(bestThreats, bestThreats);
+    }
     // Corrent chessboard from the start
     if (startThreats == 0) {
         return curQueenPositions;
@@ -274,6 +757,7 @@ Point *solveAnn(int N, int maxtime, int seed, int *movesMade) {
     int curThreats = countThreats(curQueenPositions, N); // Count threats with new position
     // Solution found if this queen is moved
     if (curThreats == 0) {
+        TRACE_EVENT(TRACE_ACCEPT, randX, curThreats);
         return curQueenPositions;
     }
 
@@ -286,6 +770,7 @@ Point *solveAnn(int N, int maxtime, int seed, int *movesMade) {
 
         if (!(r <= p)) {
             // Discard move
+            TRACE_EVENT(TRACE_REJECT, randX, curThreats);
             curQueenPositions[randX].y = prevY; // Restore position
             goto new_move_no_move;
         }
@@ -293,11 +778,256 @@ Point *solveAnn(int N, int maxtime, int seed, int *movesMade) {
     // If the threats with the move were reduced
     // Or weren't but randomly chose to keep the move then
     // Keep the move and make next move
+    TRACE_EVENT(TRACE_ACCEPT, randX, curThreats);
     startThreats = curThreats;
     (*movesMade)++;
+    PUBLISH_PROGRESS(moves, *movesMade);
+    if (curThreats < bestThreats) {
+        bestThreats = curThreats;
+        PUBLISH_PROGRESS(bestThreats, bestThreats);
+    }
     goto new_move_made_move;
 }
 
+/**
+ * @brief Helper function to place or remove a queen for solveMRV.
+ *
+ * Adds delta (+1 or -1) to the attack counters of the cells of every
+ * unassigned row that the queen at (row, col) threatens, and keeps the
+ * domain sizes of those rows up to date.
+ *
+ * @param  N         Amount of queens.
+ * @param  row       Row of the queen.
+ * @param  col       Column of the queen.
+ * @param  delta     +1 to place the queen, -1 to remove it.
+ * @param  colOf     Assigned column of each row (-1 if unassigned).
+ * @param  attacks   N*N counters of queens attacking each cell.
+ * @param  domSize   Amount of legal columns left in each row.
+ * @return           Returns 1 if an unassigned row was left with no legal column.
+ */
+static int propagateMRV(int N, int row, int col, int delta, int *colOf, int *attacks, int *domSize) {
+    int r, k, d, c, wipeout = 0;
+    int *cells;
+    for (r = 0; r < N; r++) {
+        if (colOf[r] != -1 || r == row) {
+            continue; // Only other unassigned rows have domains
+        }
+        d = abs(r - row);
+        cells = attacks + r * N;
+        // Same column, and both diagonals (d > 0 so the cells are distinct)
+        for (k = 0; k < 3; k++) {
+            c = (k == 0) ? col : (k == 1) ? col + d : col - d;
+            if (c < 0 || c >= N) {
+                continue;
+            }
+            if (delta > 0 && cells[c]++ == 0) {
+                domSize[r]--;
+            }
+            else if (delta < 0 && --cells[c] == 0) {
+                domSize[r]++;
+            }
+        }
+        if (domSize[r] == 0) {
+            wipeout = 1;
+        }
+    }
+    return wipeout;
+}
+
+/**
+ * @brief Helper function to break ties between rows or columns in solveMRV.
+ *
+ * Hashes value with the salt of the current restart so that ties are broken
+ * in a different (but reproducible) order after every restart.
+ *
+ * @param  salt  Salt of the current restart.
+ * @param  value Row or column to hash.
+ * @return       Returns the tie-break key of value.
+ */
+static unsigned int tieBreakMRV(unsigned int salt, int value) {
+    unsigned int h = (unsigned int) value * 2654435761u ^ salt * 2246822519u;
+    h ^= h >> 15;
+    h *= 2654435761u;
+    return h ^ (h >> 13);
+}
+
+/**
+ * @brief Candidate column of a row in solveMRV.
+ */
+typedef struct {
+    int cost;         // Values removed from the other rows' domains
+    unsigned int key; // Tie-break key
+    int col;          // Column of the candidate
+} CandidateMRV;
+
+/**
+ * @brief Helper function to compare candidate columns of solveMRV by cost.
+ */
+static int compareCandidatesMRV(const void *a, const void *b) {
+    const CandidateMRV *c1 = a, *c2 = b;
+    if (c1->cost != c2->cost) {
+        return (c1->cost < c2->cost) ? -1 : 1;
+    }
+    return (c1->key < c2->key) ? -1 : (c1->key > c2->key);
+}
+
+Point *solveMRV(int N, int maxtime, int *backtracks, int *restartsCount) {
+    *backtracks = 0;
+    *restartsCount = -1; // First pass from label doesn't count (will turn to 0)
+
+    int *colOf = malloc(N * sizeof(int));           // Assigned column of each row
+    int *attacks = malloc((size_t) N * N * sizeof(int)); // Queens attacking each cell
+    int *domSize = malloc(N * sizeof(int));         // Legal columns left in each row
+    int *rowAt = malloc(N * sizeof(int));           // Row assigned at each depth
+    int *candCount = malloc(N * sizeof(int));       // Candidate columns at each depth
+    int *candIdx = malloc(N * sizeof(int));         // Next candidate to try at each depth
+    // Ordered candidate columns at each depth
+    CandidateMRV *cands = malloc((size_t) N * N * sizeof(CandidateMRV));
+    CandidateMRV *rowCands;
+    Point *solution = NULL;
+
+    // Not enough memory, restartsCount stays -1 to tell it apart from running out of time
+    if (colOf == NULL || attacks == NULL || domSize == NULL || rowAt == NULL || candCount == NULL
+        || candIdx == NULL || cands == NULL) {
+        free(colOf);
+        free(attacks);
+        free(domSize);
+        free(rowAt);
+        free(candCount);
+        free(candIdx);
+        free(cands);
+        return NULL;
+    }
+
+    int i, r, c, d, depth, row, cost, foundSolution = 0;
+    int cutoff = N, runBacktracks = 0; // Backtracks allowed and made in the current run
+    long long nodesExpanded = 0; // Queens placed, published as progress
+    unsigned int salt = 0, key, rowKey = 0;
+    clock_t timeStart = clock(), timeElapsed; // Time counter
+
+    restart_mrv:
+    (*restartsCount)++;
+    PUBLISH_PROGRESS(restarts, *restartsCount);
+    salt++;
+    runBacktracks = 0;
+    for (i = 0; i < N; i++) {
+        colOf[i] = -1;
+        domSize[i] = N;
+    }
+    memset(attacks, 0, (size_t) N * N * sizeof(int));
+
+    depth = 0;
+    next_row_mrv:
+    // Minimum remaining values: choose the unassigned row with the smallest domain
+    row = -1;
+    for (r = 0; r < N; r++) {
+        if (colOf[r] != -1) {
+            continue;
+        }
+        key = tieBreakMRV(salt, r);
+        if (row == -1 || domSize[r] < domSize[row] || (domSize[r] == domSize[row] && key < rowKey)) {
+            row = r;
+            rowKey = key;
+        }
+    }
+    rowAt[depth] = row;
+
+    // Least constraining value: order the legal columns by how many
+    // values they remove from the domains of the other unassigned rows
+    rowCands = cands + (size_t) depth * N;
+    candCount[depth] = 0;
+    candIdx[depth] = 0;
+    for (c = 0; c < N; c++) {
+        if (attacks[row * N + c] != 0) {
+            continue;
+        }
+        cost = 0;
+        for (r = 0; r < N; r++) {
+            if (colOf[r] != -1 || r == row) {
+                continue;
+            }
+            d = abs(r - row);
+            cost += (attacks[r * N + c] == 0);
+            cost += (c + d < N && attacks[r * N + c + d] == 0);
+            cost += (c - d >= 0 && attacks[r * N + c - d] == 0);
+        }
+        rowCands[candCount[depth]].cost = cost;
+        rowCands[candCount[depth]].key = tieBreakMRV(salt, c);
+        rowCands[candCount[depth]].col = c;
+        candCount[depth]++;
+    }
+    qsort(rowCands, candCount[depth], sizeof(CandidateMRV), compareCandidatesMRV);
+
+    while (depth >= 0) {
+        // Check time interval
+        timeElapsed = clock() - timeStart;
+        if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= maxtime) {
+            break;
+        }
+
+        row = rowAt[depth];
+        // Out of candidates for this row, undo the previous depth's queen
+        if (candIdx[depth] == candCount[depth]) {
+            depth--;
+            if (depth >= 0) {
+                r = rowAt[depth];
+                colOf[r] = -1;
+                propagateMRV(N, r, cands[(size_t) depth * N + candIdx[depth] - 1].col, -1, colOf, attacks, domSize);
+                (*backtracks)++;
+                // Run is stuck in a bad subtree, restart with a doubled cutoff
+                if (++runBacktracks >= cutoff) {
+                    cutoff *= 2;
+                    goto restart_mrv;
+                }
+            }
+            continue;
+        }
+
+        // Forward checking: place the queen and prune the other rows' domains
+        c = cands[(size_t) depth * N + candIdx[depth]].col;
+        candIdx[depth]++;
+        colOf[row] = c;
+        PUBLISH_PROGRESS(nodes, ++nodesExpanded);
+        PUBLISH_PROGRESS(depth, depth + 1);
+        if (propagateMRV(N, row, c, 1, colOf, attacks, domSize)) {
+            // Some row has no legal column left, try the next candidate
+            colOf[row] = -1;
+            propagateMRV(N, row, c, -1, colOf, attacks, domSize);
+            continue;
+        }
+
+        // All queens placed
+        if (depth == N - 1) {
+            foundSolution = 1;
+            break;
+        }
+        depth++;
+        goto next_row_mrv;
+    }
+
+    if (foundSolution) {
+        solution = malloc(N * sizeof(Point));
+        if (solution == NULL) {
+            *restartsCount = -1;
+        }
+        for (i = 0; solution != NULL && i < N; i++) {
+            solution[i].x = i;
+            solution[i].y = colOf[i];
+        }
+    }
+
+    // Free memory blocks
+    free(colOf);
+    free(attacks);
+    free(domSize);
+    free(rowAt);
+    free(candCount);
+    free(candIdx);
+    free(cands);
+
+    return solution;
+}
+
 #ifdef DEBUG_ALGORITHMS
 /**
  * @brief Main used for testing.
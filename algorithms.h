@@ -11,6 +11,40 @@
 #ifndef ALGORITHMS_H
 #define ALGORITHMS_H
 
+#define RUN_BUCKETS 32 // Buckets of the run-length distribution, powers of 2
+
+typedef enum {
+	RESTART_LOCAL_MIN, // Restart only at a local minimum (no cutoff)
+	RESTART_LUBY,      // Cut run k at unit * luby(k) steps (1, 1, 2, 1, 1, 2, 4, ...)
+	RESTART_GEOMETRIC, // Cut run k at unit * factor^k steps
+	RESTART_STALL      // Cut a run after unit steps without lowering its best threats
+} RestartKind;
+
+typedef struct {
+	RestartKind kind;  // When a run is cut and the board restarted
+	int unit;          // Steps of a Luby unit, first geometric cutoff, or stall limit
+	double factor;     // Growth of the geometric cutoff
+	int partial;       // 1 to re-randomize only the threatened queens at a local minimum
+} RestartPolicy;
+
+typedef struct {
+	long long runs;                 // Runs made (restarts + 1)
+	long long steps;                // Steps of all runs
+	long long buckets[RUN_BUCKETS]; // Runs of [2^i, 2^(i+1)) steps (bucket 0 also holds 0 steps)
+	long long lastRun;              // Steps of the last run (the one that found the solution)
+} RunLengths;
+
+typedef struct {
+	int N;                  // Amount of queens, at most the length the arrays were allocated for
+	int *colOf;             // Column of the queen of every row, a permutation of 0..N-1 (N ints)
+	int *diags;             // Queens on every diagonal, row + col (2N-1 ints)
+	int *antis;             // Queens on every anti-diagonal, row - col + N - 1 (2N-1 ints)
+	int *rows;              // Scratch list of rows, for partial restarts (N ints)
+	int threats;            // Pairs of queens threatening each other, only on diagonals
+	unsigned long long rng; // State of the xorshift64* generator, from seedRandom
+	int publish;            // 1 to publish progress to telemetry, 0 for searches in many threads
+} Permutation;
+
 /**
  * @brief Helper function to count queens at threat on chessboard.
  *
@@ -72,14 +106,35 @@ Point *solveDFS(int N, int maxtime);
  * 6. If currentThreats aren't less than startThreats then restart the process
  * from step 1.
  *
+ * A step is one search of step 4, with the move or partial restart after it.
+ * A policy can cut runs short and restart (Luby sequence, geometric cutoffs,
+ * or a limit of steps without lowering the run's best threats), and with
+ * partial set a local minimum re-randomizes only the threatened queens and
+ * the run goes on, so only cutoffs make full restarts. The steps of every
+ * run are recorded in a log2 histogram, to tune the cutoffs for the lowest
+ * expected time to solution.
+ *
+ * With permutation set, the search runs in permutation space instead: every
+ * column holds exactly one queen, so only diagonals can have threats. Each
+ * start is a greedy permutation that places row by row a queen on a column
+ * not used yet, avoiding used diagonals, and moves swap the columns of two
+ * rows, one of them threatened. Counters of queens on every diagonal give
+ * the change in threats of a swap in O(1) time. This search draws from its
+ * own xorshift64* generator seeded from seed instead of rand(), and maxtime
+ * is measured in wall time.
+ *
  * @param  N             Amount of queens.
  * @param  maxtime       Max time to spend running the algorithm.
  * @param  seed          Seed for rand() function.
+ * @param  permutation   1 to search permutations with swap moves, 0 for moves of one queen.
+ * @param  policy        Restart policy, or null to restart only at local minima.
+ * @param  runLengths    Run-length distribution to be filled in and returned, or null.
  * @param  restartsCount Counter of restarts to be modified and returned.
  * @param  movesMade     Counter of moves to be modified and returned.
  * @return  Returns solution array of points if found or null if out of time
  */
-Point *solveHill(int N, int maxtime, int seed, int *restartsCount, int *movesMade);
+Point *solveHill(int N, int maxtime, int seed, int permutation, const RestartPolicy *policy,
+                 RunLengths *runLengths, int *restartsCount, int *movesMade);
 
 /**
  * @brief Function that uses a simulated annealing algorithm to solve the nQueens problem.
@@ -106,12 +161,84 @@ Point *solveHill(int N, int maxtime, int seed, int *restartsCount, int *movesMad
  * If r <= p then change the position of a queen to the marked one.
  * 7. Goto step 2.
  *
+ * With permutation set, the search runs in permutation space as in solveHill:
+ * it starts from a greedy permutation, and each move swaps the columns of a
+ * random threatened queen and a random other row, with Dt found in O(1) time,
+ * drawing from a xorshift64* generator seeded from seed and stopping at
+ * maxtime of wall time.
+ *
  * @param  N       Amount of queens.
  * @param  maxtime Max time to spend running the algorithm.
  * @param  seed    Seed for rand() function.
+ * @param  permutation 1 to search permutations with swap moves, 0 for moves of one queen.
  * @param  movesMade     Counter of moves to be modified and returned.
  * @return         Returns solution array of points if found or null if out of time
  */
-Point *solveAnn(int N, int maxtime, int seed, int *movesMade);
+Point *solveAnn(int N, int maxtime, int seed, int permutation, int *movesMade);
+
+/**
+ * @brief Function that runs the permutation-space hill climbing of solveHill on caller-owned boards.
+ *
+ * The arrays of p are allocated by the caller for at least p->N queens, so a
+ * caller solving many boards (such as the daemon's workers) allocates them
+ * once. Random numbers are drawn from p->rng and the search stops at deadline.
+ * Counters and runLengths are reset first.
+ *
+ * @param  p             Permutation with N, arrays, and rng set, to be filled in.
+ * @param  deadline      Time on the CLOCK_MONOTONIC clock to stop at.
+ * @param  policy        Restart policy, or null to restart only at local minima.
+ * @param  runLengths    Run-length distribution to be filled in and returned, or null.
+ * @param  restartsCount Counter of restarts to be modified and returned.
+ * @param  movesMade     Counter of moves to be modified and returned.
+ * @return               Returns 1 if solved (colOf holds the solution) or 0 if the deadline passed
+ */
+int hillPermutation(Permutation *p, const struct timespec *deadline, const RestartPolicy *policy,
+                    RunLengths *runLengths, int *restartsCount, int *movesMade);
+
+/**
+ * @brief Function that runs the permutation-space annealing of solveAnn on caller-owned boards.
+ *
+ * As hillPermutation, the arrays of p are allocated by the caller, random
+ * numbers are drawn from p->rng, and the search stops at deadline.
+ *
+ * @param  p         Permutation with N, arrays, and rng set, to be filled in.
+ * @param  deadline  Time on the CLOCK_MONOTONIC clock to stop at.
+ * @param  movesMade Counter of moves to be modified and returned.
+ * @return           Returns 1 if solved (colOf holds the solution) or 0 if the deadline passed
+ */
+int annPermutation(Permutation *p, const struct timespec *deadline, int *movesMade);
+
+/**
+ * @brief Function that uses a DFS algorithm with constraint propagation to solve the nQueens problem.
+ *
+ * This function does a depth-first search like solveDFS but keeps, for each
+ * row without a queen, the domain of columns that are not threatened by the
+ * queens placed so far (forward checking). Rows are not filled in order;
+ * the row with the fewest legal columns is chosen next (minimum remaining values),
+ * and its columns are tried starting from the one that removes the fewest
+ * values from the other rows' domains (least constraining value).
+ * Ties are broken by a hash salted per run. As the search time is heavy-tailed,
+ * a run that makes more backtracks than a cutoff (starting at N) is restarted
+ * with a new salt and a doubled cutoff, which keeps the search complete.
+ *
+ * The algorithm is the following:
+ * 1. Set every row's domain to all N columns.
+ * 2. Choose the row with the smallest domain and order its columns by cost.
+ * 3. For each column of the row:
+ * a. Place the queen and remove the threatened cells from the other rows' domains.
+ * b. If a row is left with an empty domain, undo the placement and try the next column.
+ * c. If all queens are placed return the positions.
+ * d. Else go to step 2 for the next row.
+ * 4. If all columns of a row failed, undo the previous row's queen (backtrack).
+ * a. If the backtracks exceed the cutoff, double it and restart from step 1.
+ * 5. If no solution was found or time has expired return null.
+ *
+ * @param  N          Amount of queens.
+ * @param  maxtime    Max time to spend running the algorithm.
+ * @param  backtracks    Counter of backtracks to be modified and returned.
+ * @param  restartsCount Counter of restarts to be modified and returned, -1 if memory can't be allocated.
+ * @return               Returns solution array of points if found or null if not.
+ */
+Point *solveMRV(int N, int maxtime, int *backtracks, int *restartsCount);
 
 #endif
@@ -0,0 +1,318 @@
+/**
+ * @file autoselect.c
+ * @brief Implements functions of autoselect.h file.
+ */
+
+#include "autoselect.h"
+#include "algorithms.h"
+#include "dlx.h"
+#include "tempering.h"
+#include "util.h"
+#include <unistd.h>	// for sysconf
+
+const char *ENGINE_NAMES[ENGINE_COUNT] = {"dfs", "mrv", "dlx", "hill", "ann", "pt"};
+const double DEFAULT_FRACTION = 0.5; // Part of maxtime given to the primary engine
+
+#define CANDIDATES (ENGINE_COUNT + 2) // Engines, and hill and ann again in the permutation space
+
+/**
+ * @brief Helper function to check if an engine searches exhaustively.
+ */
+static int isExhaustive(Engine engine) {
+    return engine == ENGINE_DFS || engine == ENGINE_MRV || engine == ENGINE_DLX;
+}
+
+/**
+ * @brief Helper function to check if two engine choices are the same.
+ */
+static int isSameChoice(EngineChoice a, EngineChoice b) {
+    return a.engine == b.engine && a.param == b.param;
+}
+
+/**
+ * @brief Helper function to parse an engine name, with an optional ":param".
+ * @return Returns EXIT_FAILURE if the name isn't an engine or EXIT_SUCCESS.
+ */
+static int parseEngine(const char *name, EngineChoice *choice) {
+    char *convP;
+    const char *colon = strchr(name, ':');
+    size_t length = (colon != NULL) ? (size_t) (colon - name) : strlen(name);
+    int e;
+
+    for (e = 0; e < ENGINE_COUNT; e++) {
+        if (strlen(ENGINE_NAMES[e]) == length && strncmp(name, ENGINE_NAMES[e], length) == 0)
+            break;
+    }
+    if (e == ENGINE_COUNT)
+        return EXIT_FAILURE;
+
+    choice->engine = (Engine) e;
+    choice->param = (e == ENGINE_PT) ? 4 : 0;
+    if (colon != NULL) {
+        if (e == ENGINE_HILL || e == ENGINE_ANN) {
+            if (strcmp(colon + 1, "perm") != 0)
+                return EXIT_FAILURE;
+            choice->param = 1;
+            return EXIT_SUCCESS;
+        }
+        if (e != ENGINE_PT)
+            return EXIT_FAILURE;
+        choice->param = strtol(colon + 1, &convP, 10);
+        if (*convP != '\0' || choice->param < 1 || choice->param > MAX_REPLICAS)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+char *engineName(EngineChoice choice, char *name) {
+    if (choice.engine == ENGINE_COUNT)
+        strcpy(name, "none");
+    else if (choice.engine == ENGINE_PT)
+        sprintf(name, "%s:%d", ENGINE_NAMES[choice.engine], choice.param);
+    else if ((choice.engine == ENGINE_HILL || choice.engine == ENGINE_ANN) && choice.param)
+        sprintf(name, "%s:perm", ENGINE_NAMES[choice.engine]);
+    else
+        strcpy(name, ENGINE_NAMES[choice.engine]);
+    return name;
+}
+
+void defaultCalibration(CalibrationTable *table) {
+    table->rows = 1;
+    table->row[0].maxN = INT_MAX;
+    table->row[0].primary.engine = ENGINE_MRV;
+    table->row[0].primary.param = 0;
+    table->row[0].fallback.engine = ENGINE_ANN;
+    table->row[0].fallback.param = 1; // In the permutation space, fastest on large boards
+    table->row[0].fraction = DEFAULT_FRACTION;
+}
+
+int loadCalibration(const char *path, CalibrationTable *table) {
+    if (path == NULL || table == NULL)
+        return EXIT_FAILURE;
+
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+        return EXIT_FAILURE;
+
+    char line[256], primary[16], fallback[16], extra;
+    int fields, status = EXIT_SUCCESS;
+    CalibrationRow *row;
+
+    table->rows = 0;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (line[strspn(line, " \t\n")] == '\0' || line[strspn(line, " \t")] == '#')
+            continue;
+        if (table->rows == MAX_CALIBRATION_ROWS) {
+            status = EXIT_FAILURE;
+            break;
+        }
+        row = &table->row[table->rows];
+        fields = sscanf(line, "%d %15s %15s %lf %c", &row->maxN, primary, fallback, &row->fraction, &extra);
+        row->fallback.engine = ENGINE_COUNT;
+        row->fallback.param = 0;
+        if (fields != 4 || row->maxN < 1 || row->fraction <= 0 || row->fraction > 1
+            || parseEngine(primary, &row->primary) == EXIT_FAILURE
+            || (strcmp(fallback, "none") != 0 && parseEngine(fallback, &row->fallback) == EXIT_FAILURE)
+            || isSameChoice(row->fallback, row->primary)
+            || (table->rows > 0 && row->maxN <= table->row[table->rows - 1].maxN)) {
+            status = EXIT_FAILURE;
+            break;
+        }
+        table->rows++;
+    }
+    fclose(fp);
+
+    return (table->rows == 0) ? EXIT_FAILURE : status;
+}
+
+int writeCalibration(const char *path, const CalibrationTable *table) {
+    FILE *fp = fopen(path, "w");
+    char primary[16], fallback[16];
+    int i;
+
+    if (fp == NULL)
+        return EXIT_FAILURE;
+
+    fprintf(fp, "# Calibration table for the auto algorithm, regenerate with 'make calibrate'\n");
+    fprintf(fp, "# maxN primary fallback fraction\n");
+    for (i = 0; i < table->rows; i++) {
+        fprintf(fp, "%d %s %s %.2f\n", table->row[i].maxN, engineName(table->row[i].primary, primary),
+                engineName(table->row[i].fallback, fallback), table->row[i].fraction);
+    }
+
+    return (fclose(fp) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+Point *runEngine(EngineChoice choice, int N, int maxtime, int seed) {
+    int restartsCount, movesMade, backtracks;
+    Point *solution = NULL;
+    DLX *dlx;
+    TemperingStats stats;
+
+    switch (choice.engine) {
+        case ENGINE_DFS:
+            return solveDFS(N, maxtime);
+        case ENGINE_MRV:
+            return solveMRV(N, maxtime, &backtracks, &restartsCount);
+        case ENGINE_DLX:
+            if (initDLX(&dlx, N) == EXIT_SUCCESS) {
+                solution = solveDLX(dlx, maxtime, 0);
+                freeDLX(dlx);
+            }
+            return solution;
+        case ENGINE_HILL:
+            return solveHill(N, maxtime, seed, choice.param, NULL, NULL, &restartsCount, &movesMade);
+        case ENGINE_ANN:
+            return solveAnn(N, maxtime, seed, choice.param, &movesMade);
+        case ENGINE_PT:
+            return solveTempering(N, maxtime, seed, choice.param, &stats);
+        default:
+            return NULL;
+    }
+}
+
+int calibrate(int maxN, int budget, int seeds, CalibrationTable *table, FILE *log) {
+    if (maxN < 4 || budget < 1 || seeds < 1 || table == NULL)
+        return EXIT_FAILURE;
+
+    int N, e, c, s, runs, i, j, amount = 0, best, second, retired[CANDIDATES] = {0};
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    // At least 4 replicas for pt, one per processor
+    int ptThreads = (int) (cpus > 4 ? (cpus < MAX_REPLICAS ? cpus : MAX_REPLICAS) : 4);
+    double times[CANDIDATES], *runTimes = malloc(seeds * sizeof(double)), tmp;
+    char name[16];
+    EngineChoice candidates[CANDIDATES], none = {ENGINE_COUNT, 0};
+    CalibrationRow *row;
+    struct timespec start;
+    Point *solution;
+
+    for (e = 0; e < ENGINE_COUNT; e++) {
+        candidates[amount].engine = (Engine) e;
+        candidates[amount++].param = (e == ENGINE_PT) ? ptThreads : 0;
+        // Local searches run in both state spaces
+        if (e == ENGINE_HILL || e == ENGINE_ANN) {
+            candidates[amount].engine = (Engine) e;
+            candidates[amount++].param = 1;
+        }
+    }
+
+    table->rows = 0;
+    // N=3 first, below 4 only exhaustive searches can prove there's no solution
+    for (N = 3; N <= maxN && table->rows < MAX_CALIBRATION_ROWS; N = (N < 4) ? 4 : 2 * N) {
+        for (c = 0; c < amount; c++) {
+            times[c] = -1; // Not measured or ran out of budget
+            if (retired[c] || (N < 4 && !isExhaustive(candidates[c].engine)))
+                continue;
+
+            runs = isExhaustive(candidates[c].engine) ? 1 : seeds;
+            for (s = 0; s < runs; s++) {
+                clock_gettime(CLOCK_MONOTONIC, &start);
+                solution = runEngine(candidates[c], N, budget, s + 1);
+                runTimes[s] = secondsSince(&start);
+                // Exhaustive search that finished within budget proved there's no solution
+                if (solution == NULL && (!isExhaustive(candidates[c].engine) || runTimes[s] >= budget))
+                    runTimes[s] = budget + 1;
+                free(solution);
+            }
+
+            // Median of the runs, insertion sort as runs are few
+            for (i = 1; i < runs; i++) {
+                for (j = i; j > 0 && runTimes[j - 1] > runTimes[j]; j--) {
+                    tmp = runTimes[j];
+                    runTimes[j] = runTimes[j - 1];
+                    runTimes[j - 1] = tmp;
+                }
+            }
+            if (runTimes[runs / 2] <= budget) {
+                times[c] = runTimes[runs / 2];
+            }
+            else {
+                retired[c] = 1; // Larger N would only be slower
+            }
+
+            if (log != NULL) {
+                if (times[c] >= 0)
+                    fprintf(log, "N=%-6d %-9s median %.6f secs\n", N, engineName(candidates[c], name), times[c]);
+                else
+                    fprintf(log, "N=%-6d %-9s out of budget\n", N, engineName(candidates[c], name));
+            }
+        }
+
+        // Fastest engine is the primary, second fastest the fallback
+        best = second = amount;
+        for (c = 0; c < amount; c++) {
+            if (times[c] < 0)
+                continue;
+            if (best == amount || times[c] < times[best]) {
+                second = best;
+                best = c;
+            }
+            else if (second == amount || times[c] < times[second]) {
+                second = c;
+            }
+        }
+        if (best == amount)
+            break; // No engine solves this N within budget, last row covers it
+        if (N < 4)
+            second = amount; // Rerunning a search that proved there's no solution can't help
+
+        // Extend the previous row if it picked the same engines
+        row = &table->row[table->rows];
+        if (table->rows > 0 && isSameChoice(table->row[table->rows - 1].primary, candidates[best])
+            && isSameChoice(table->row[table->rows - 1].fallback, (second < amount) ? candidates[second] : none)) {
+            table->row[table->rows - 1].maxN = N;
+            continue;
+        }
+        row->maxN = N;
+        row->primary = candidates[best];
+        row->fallback = (second < amount) ? candidates[second] : none;
+        // Only one engine left, the others ran out of budget so none can fall back
+        row->fraction = (second < amount) ? DEFAULT_FRACTION : 1;
+        table->rows++;
+    }
+    free(runTimes);
+
+    if (table->rows == 0)
+        defaultCalibration(table);
+
+    return EXIT_SUCCESS;
+}
+
+Point *solveAuto(int N, int maxtime, int seed, const CalibrationTable *table,
+                 EngineChoice *used, int *usedFallback) {
+    const CalibrationRow *row = &table->row[table->rows - 1];
+    int i, budget;
+    struct timespec start;
+    double elapsed;
+    Point *solution;
+
+    // First row that covers N, or the last row
+    for (i = 0; i < table->rows; i++) {
+        if (N <= table->row[i].maxN) {
+            row = &table->row[i];
+            break;
+        }
+    }
+
+    budget = (row->fallback.engine == ENGINE_COUNT) ? maxtime : (int) (maxtime * row->fraction);
+    if (budget < 1)
+        budget = 1;
+    if (budget > maxtime)
+        budget = maxtime;
+
+    *used = row->primary;
+    *usedFallback = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    solution = runEngine(row->primary, N, budget, seed);
+    elapsed = secondsSince(&start);
+
+    // Exhaustive search that finished within its budget proved there's no solution
+    if (solution != NULL || (isExhaustive(row->primary.engine) && elapsed < budget) || budget >= maxtime) {
+        return solution;
+    }
+
+    *used = row->fallback;
+    *usedFallback = 1;
+    return runEngine(row->fallback, N, maxtime - budget, seed);
+}
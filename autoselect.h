@@ -0,0 +1,153 @@
+/**
+ *@file autoselect.h
+ *@brief Automatic algorithm selection from a calibration table.
+ *
+ * This file includes function prototypes to pick the engine that solves
+ * the nQueens problem fastest for a given N, from a calibration table made
+ * by a benchmark sweep of all engines on the target machine. The table is
+ * stored in a small text file with one row per range of N:
+ *
+ *     # maxN primary fallback fraction
+ *     8 dfs mrv 0.5
+ *     512 mrv pt:4 0.5
+ *
+ * A row applies to every N up to its maxN (the last row applies to any
+ * larger N). The primary engine is given fraction of maxtime, and if it
+ * doesn't finish, the fallback engine gets the rest. A fallback of none
+ * gives the primary all of maxtime. An engine can take a parameter after
+ * a colon: the threads of pt, or perm for hill and ann to search the
+ * permutation space.
+ */
+
+#ifndef AUTOSELECT_H
+#define AUTOSELECT_H
+#include "def.h"
+
+#define MAX_CALIBRATION_ROWS 32
+
+typedef enum {
+	ENGINE_DFS,
+	ENGINE_MRV,
+	ENGINE_DLX,
+	ENGINE_HILL,
+	ENGINE_ANN,
+	ENGINE_PT,
+	ENGINE_COUNT
+} Engine;
+
+typedef struct {
+	Engine engine;
+	int param;         // Threads for pt, 1 for hill and ann in the permutation space, unused otherwise
+} EngineChoice;
+
+typedef struct {
+	int maxN;              // Largest N the row applies to
+	EngineChoice primary;  // Engine tried first
+	EngineChoice fallback; // Engine tried if the primary runs out of its budget, ENGINE_COUNT if none
+	double fraction;       // Part of maxtime given to the primary engine
+} CalibrationRow;
+
+typedef struct {
+	int rows;
+	CalibrationRow row[MAX_CALIBRATION_ROWS]; // Sorted by maxN
+} CalibrationTable;
+
+/**
+ * @brief Function to get the name of an engine choice, as written in tables.
+ *
+ * @param  choice Engine choice
+ * @param  name   Buffer of at least 16 chars to write the name to
+ * @return        Returns name.
+ */
+char *engineName(EngineChoice choice, char *name);
+
+/**
+ * @brief Function to fill a table with the built-in default calibration.
+ *
+ * Used when no calibration file can be read: DFS with constraint
+ * propagation first, simulated annealing in the permutation space
+ * (ann:perm) as the fallback.
+ *
+ * @param  table Table to fill
+ */
+void defaultCalibration(CalibrationTable *table);
+
+/**
+ * @brief Function to read a calibration table from a file.
+ *
+ * Empty lines and lines starting with '#' are skipped.
+ * If the file can't be read, a row is malformed or falls back to its own
+ * primary, rows aren't sorted by maxN, or there are no rows EXIT_FAILURE
+ * is returned.
+ *
+ * @param  path  Path of the file
+ * @param  table Table to fill
+ * @return       EXIT_FAILURE or EXIT_SUCCESS
+ */
+int loadCalibration(const char *path, CalibrationTable *table);
+
+/**
+ * @brief Function to write a calibration table to a file.
+ *
+ * @param  path  Path of the file
+ * @param  table Table to write
+ * @return       EXIT_FAILURE if the file can't be written or EXIT_SUCCESS
+ */
+int writeCalibration(const char *path, const CalibrationTable *table);
+
+/**
+ * @brief Function to make a calibration table by benchmarking all engines.
+ *
+ * This function sweeps N over powers of 2 from 4 up to maxN and runs every
+ * engine (hill and ann in both state spaces) with budget seconds (seeds times for the randomized ones), measuring
+ * wall time. An engine that runs out of budget is not tried at larger N.
+ * For every N the engine with the lowest median time becomes the primary
+ * and the second lowest the fallback, and equal consecutive rows are merged.
+ * If only one engine is left, the row has no fallback and gives the primary
+ * all of maxtime.
+ * A first row for N up to 3 is measured with the exhaustive engines only,
+ * as boards 2 and 3 have no solution for a local search to find, and has
+ * no fallback.
+ * Progress of the sweep is printed to log (if not null).
+ *
+ * @param  maxN   Largest N of the sweep
+ * @param  budget Max time of each run
+ * @param  seeds  Runs of each randomized engine
+ * @param  table  Table to fill
+ * @param  log    Stream to print the measurements to, or null
+ * @return        EXIT_FAILURE if maxN is less than 4 or EXIT_SUCCESS
+ */
+int calibrate(int maxN, int budget, int seeds, CalibrationTable *table, FILE *log);
+
+/**
+ * @brief Function to run an engine on the nQueens problem.
+ *
+ * @param  choice  Engine (and parameter) to run
+ * @param  N       Amount of queens.
+ * @param  maxtime Max time to spend running the engine.
+ * @param  seed    Seed of the randomized engines.
+ * @return         Returns solution array of points if found or null if not.
+ */
+Point *runEngine(EngineChoice choice, int N, int maxtime, int seed);
+
+/**
+ * @brief Function that picks an engine from a calibration table to solve the nQueens problem.
+ *
+ * This function runs the primary engine of the table's row for N with
+ * its fraction of maxtime (at least 1 second), or all of it if the row has
+ * no fallback. If it doesn't find a solution within it, the fallback engine
+ * runs for the rest of maxtime, unless the primary is an exhaustive search
+ * that finished early (no solution exists).
+ *
+ * @param  N            Amount of queens.
+ * @param  maxtime      Max time to spend running the algorithm.
+ * @param  seed         Seed of the randomized engines.
+ * @param  table        Calibration table
+ * @param  used         Engine that returned, to be modified and returned.
+ * @param  usedFallback Set to 1 if the fallback engine ran, to be modified and returned.
+ * @return              Returns solution array of points if found or null if not.
+ */
+Point *solveAuto(int N, int maxtime, int seed, const CalibrationTable *table,
+                 EngineChoice *used, int *usedFallback);
+
+#endif
@@ -0,0 +1,193 @@
+/**
+ * @file batchhill.c
+ * @brief Implements functions of batchhill.h file.
+ */
+
+#include "batchhill.h"
+#include "telemetry.h"
+#include "util.h"
+
+/**
+ * @brief One 16-bit counter per lane, operated on as a single vector.
+ */
+typedef short Lanes __attribute__((vector_size(BATCH_LANES * sizeof(short))));
+
+/**
+ * @brief Boards in flight, entry [line][lane] belongs to the board of the lane.
+ */
+typedef struct {
+    int N;
+    Lanes *colOf;                         // Column of the queen of every row
+    Lanes *cols;                          // Queens on every column
+    Lanes *diags;                         // Queens on every diagonal (row + col)
+    Lanes *antis;                         // Queens on every anti-diagonal (row - col + N - 1)
+    int threats[BATCH_LANES];             // Pairs of queens threatening each other
+    long long job[BATCH_LANES];           // Board of the lane, -1 if idle
+    unsigned long long rng[BATCH_LANES];  // Random number generator of the lane
+} Batch;
+
+/**
+ * @brief Helper function to place each queen of a lane at a random column.
+ */
+static void randomLane(Batch *b, int lane) {
+    int i, c, N = b->N;
+
+    for (i = 0; i < N; i++) {
+        b->cols[i][lane] = 0;
+    }
+    for (i = 0; i < 2 * N - 1; i++) {
+        b->diags[i][lane] = 0;
+        b->antis[i][lane] = 0;
+    }
+    b->threats[lane] = 0;
+    for (i = 0; i < N; i++) {
+        c = nextRandom(&b->rng[lane]) % N;
+        b->colOf[i][lane] = c;
+        // Each queen threatens the queens already on its lines
+        b->threats[lane] += b->cols[c][lane]++ + b->diags[i + c][lane]++ + b->antis[i - c + N - 1][lane]++;
+    }
+}
+
+/**
+ * @brief Helper function to give a lane the next board of the queue, or leave it idle.
+ *
+ * Boards placed without threats (N = 1) are written out and the next one is taken.
+ */
+static void refillLane(Batch *b, int lane, int seed, long long *nextJob, long long boards,
+                       int *columns, BatchStats *stats) {
+    int i;
+
+    while (*nextJob < boards) {
+        b->job[lane] = (*nextJob)++;
+        b->rng[lane] = seedRandom((unsigned long long) seed + b->job[lane]);
+        randomLane(b, lane);
+        if (b->threats[lane] != 0) {
+            return;
+        }
+        if (columns != NULL) {
+            for (i = 0; i < b->N; i++) {
+                columns[b->job[lane] * b->N + i] = b->colOf[i][lane];
+            }
+        }
+        stats->solved++;
+    }
+    b->job[lane] = -1;
+}
+
+int solveHillBatch(int N, int maxtime, int seed, long long boards, int *columns, BatchStats *stats) {
+    if (N < 1 || N > BATCH_MAX_N || boards < 0 || stats == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    Batch b;
+    void *memory;
+    Lanes bestDelta, bestRow, bestCol, here, delta, better;
+    long long nextJob = 0, k;
+    int i, j, lane, y, c, active, lines = N + N + 2 * (2 * N - 1);
+    clock_t timeStart = clock(), timeElapsed; // Time counter
+
+    memset(stats, 0, sizeof(BatchStats));
+    // Vectors need their own alignment, malloc may give less
+    if (posix_memalign(&memory, sizeof(Lanes), lines * sizeof(Lanes)) != 0) {
+        return EXIT_FAILURE;
+    }
+    memset(memory, 0, lines * sizeof(Lanes));
+    b.N = N;
+    b.colOf = memory;
+    b.cols = b.colOf + N;
+    b.diags = b.cols + N;
+    b.antis = b.diags + 2 * N - 1;
+
+    if (columns != NULL) {
+        for (k = 0; k < boards * N; k++) {
+            columns[k] = -1;
+        }
+    }
+    for (lane = 0; lane < BATCH_LANES; lane++) {
+        refillLane(&b, lane, seed, &nextJob, boards, columns, stats);
+    }
+
+    for (;;) {
+        active = 0;
+        for (lane = 0; lane < BATCH_LANES; lane++) {
+            active += (b.job[lane] >= 0);
+        }
+        if (active == 0) {
+            break;
+        }
+
+        // Check time interval
+        timeElapsed = clock() - timeStart;
+        if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= maxtime) {
+            stats->timeExpired = 1;
+            break;
+        }
+
+        // Find the move of every lane that lowers the threats the most
+        // Idle lanes compute too, their moves are ignored
+        memset(&bestDelta, 0, sizeof(Lanes));
+        memset(&bestRow, 0, sizeof(Lanes));
+        memset(&bestCol, 0, sizeof(Lanes));
+        for (i = 0; i < N; i++) {
+            // Threats of the row's queen where it stands, without itself (gather)
+            for (lane = 0; lane < BATCH_LANES; lane++) {
+                y = b.colOf[i][lane];
+                here[lane] = b.cols[y][lane] + b.diags[i + y][lane] + b.antis[i - y + N - 1][lane] - 3;
+            }
+            // Staying put gives +3, so the current column is never picked
+            for (j = 0; j < N; j++) {
+                delta = b.cols[j] + b.diags[i + j] + b.antis[i - j + N - 1] - here;
+                better = delta < bestDelta;
+                bestDelta = (better & delta) | (~better & bestDelta);
+                bestRow = (better & (short) i) | (~better & bestRow);
+                bestCol = (better & (short) j) | (~better & bestCol);
+            }
+        }
+        stats->sweeps++;
+
+        // Move, restart, or refill each lane with a board
+        for (lane = 0; lane < BATCH_LANES; lane++) {
+            if (b.job[lane] < 0) {
+                continue;
+            }
+            stats->laneSweeps++;
+
+            if (bestDelta[lane] < 0) {
+                i = bestRow[lane];
+                y = b.colOf[i][lane];
+                c = bestCol[lane];
+                b.cols[y][lane]--;
+                b.diags[i + y][lane]--;
+                b.antis[i - y + N - 1][lane]--;
+                b.cols[c][lane]++;
+                b.diags[i + c][lane]++;
+                b.antis[i - c + N - 1][lane]++;
+                b.colOf[i][lane] = c;
+                b.threats[lane] += bestDelta[lane];
+                stats->moves++;
+            }
+            else {
+                randomLane(&b, lane);
+                stats->restarts++;
+            }
+
+            if (b.threats[lane] == 0) {
+                if (columns != NULL) {
+                    for (i = 0; i < N; i++) {
+                        columns[b.job[lane] * N + i] = b.colOf[i][lane];
+                    }
+                }
+                stats->solved++;
+                refillLane(&b, lane, seed, &nextJob, boards, columns, stats);
+            }
+        }
+        PUBLISH_PROGRESS(nodes, stats->solved);
+        PUBLISH_PROGRESS(moves, stats->moves);
+        PUBLISH_PROGRESS(restarts, stats->restarts);
+    }
+
+    stats->secondsSpent = (float) (clock() - timeStart)/CLOCKS_PER_SEC;
+    free(memory);
+
+    return EXIT_SUCCESS;
+}
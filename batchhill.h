@@ -0,0 +1,62 @@
+/**
+ *@file batchhill.h
+ *@brief Hill climbing on many small boards at once, one board per SIMD lane.
+ *
+ * This file includes the function prototype of a batched hill-climbing solver
+ * for throughput workloads, where many boards of the same small N must be
+ * solved with different seeds. The boards are laid out lane-wise: entry
+ * [line][lane] of every counter array belongs to the board of that lane, so
+ * the threats of a candidate move are computed for all lanes with one vector
+ * operation (GCC vector extensions, which the compiler maps to the SIMD
+ * instructions of the target).
+ */
+
+#ifndef BATCHHILL_H
+#define BATCHHILL_H
+#include "def.h"
+
+#define BATCH_LANES 16 // Boards solved in lockstep
+#define BATCH_MAX_N 32 // Largest N, so counters and deltas fit in 16-bit lanes
+
+typedef struct {
+	long long solved;       // Boards solved
+	long long restarts;     // Restarts made by all lanes
+	long long moves;        // Queens moved by all lanes
+	long long sweeps;       // Lockstep sweeps over all candidate moves
+	long long laneSweeps;   // Sweeps of lanes that had a board (for utilization)
+	int timeExpired;        // 1 if the batch was stopped by maxtime
+	double secondsSpent;    // CPU time spent
+} BatchStats;
+
+/**
+ * @brief Function that uses hill climbing to solve many nQueens boards in lockstep.
+ *
+ * This function solves boards boards of N queens, board k with seed
+ * seed + k, keeping BATCH_LANES boards in flight. Every lane runs the
+ * algorithm of solveHill on its own board, with counters of queens on every
+ * column and diagonal so the change in threats of a move is found in O(1).
+ * When a lane solves its board, it's refilled with the next board of the
+ * job queue; lanes stay idle once the queue is empty.
+ *
+ * The algorithm is the following:
+ * 1. Each lane takes a board from the queue and places each queen in a row, at a random column.
+ * 2. For every row and column, find the change in threats of moving the
+ * row's queen there for all lanes at once, and keep the lowest change of
+ * each lane with masked updates.
+ * 3. Each lane with a change lower than 0 moves its queen; if its board has
+ * no threats, it's written to columns and the lane goes to step 1.
+ * 4. Each other lane restarts its board from random columns.
+ * 5. Go to step 2 until the queue is empty and all lanes are idle.
+ *
+ * @param  N       Amount of queens (1..BATCH_MAX_N).
+ * @param  maxtime Max time to spend solving the batch.
+ * @param  seed    Seed of the first board.
+ * @param  boards  Amount of boards to solve.
+ * @param  columns Array of boards * N columns to write solution k at k * N
+ *                 (unsolved boards are left as -1), or null.
+ * @param  stats   Statistics to be filled in and returned.
+ * @return         EXIT_FAILURE if N is out of range or memory can't be allocated else EXIT_SUCCESS
+ */
+int solveHillBatch(int N, int maxtime, int seed, long long boards, int *columns, BatchStats *stats);
+
+#endif
@@ -0,0 +1,307 @@
+/**
+ * @file microbench.c
+ * @brief Microbenchmarks of the kernels that dominate the solvers' profile.
+ *
+ * This program measures the cost of countThreats at various N, push and pop
+ * of the stack, rand() draws, the clock checks done by every solver loop,
+ * and board initialization. Each kernel is run in batches that take a few
+ * milliseconds, repeated to get the median and spread of ns/op
+ * (and cycles/op on x86, from the time stamp counter).
+ * Results are compared against a stored baseline file, and the program
+ * fails when a kernel's median is slower than the baseline by more than
+ * a threshold percentage.
+ *
+ * Syntax requires pairs, all optional:
+ * baseline + baseline file to compare against (default bench/baseline.txt),
+ * threshold + allowed regression percentage (default 25),
+ * write + file to save the results to as a new baseline.
+ * For example: ./microbench baseline bench/baseline.txt threshold 10
+ */
+
+#include "../algorithms.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>	// for __rdtsc
+#define HAS_TSC 1
+#else
+#define HAS_TSC 0
+#endif
+
+#define REPETITIONS 15     // Batches measured per kernel
+#define BATCH_NSECS 5e6    // Target duration of a batch
+#define MAX_KERNELS 32
+#define NAME_LENGTH 32
+
+typedef struct {
+    char name[NAME_LENGTH];
+    double nsPerOp;     // Median of the batches
+    double spread;      // Median absolute deviation of the batches (%)
+    double cyclesPerOp; // Median of the batches (-1 without a cycle counter)
+} Result;
+
+static volatile long long sink; // Keeps kernel results alive
+static Point *board;            // Board of the kernel being measured
+static int boardSize;
+static Stack *stack;
+
+/**
+ * @brief Helper function to read a monotonic clock in nanoseconds.
+ */
+static double nowNsecs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+/**
+ * @brief Helper function to read the cycle counter (0 without one).
+ */
+static unsigned long long nowCycles(void) {
+#if HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Helper function to fill the board with a random queen in each row.
+ */
+static void randomBoard(int N) {
+    int i;
+    for (i = 0; i < N; i++) {
+        board[i].x = i;
+        board[i].y = rand() % N;
+    }
+    boardSize = N;
+}
+
+static void kernelCountThreats(long long ops) {
+    long long i, total = 0;
+    for (i = 0; i < ops; i++) {
+        total += countThreats(board, boardSize);
+    }
+    sink = total;
+}
+
+static void kernelPushPop(long long ops) {
+    long long i, total = 0;
+    Point *popped;
+    int length;
+    for (i = 0; i < ops; i++) {
+        push(board, boardSize, stack);
+        pop(stack, &popped, &length);
+        total += popped[length - 1].y;
+        free(popped);
+    }
+    sink = total;
+}
+
+static void kernelRand(long long ops) {
+    long long i, total = 0;
+    for (i = 0; i < ops; i++) {
+        total += rand() % boardSize;
+    }
+    sink = total;
+}
+
+static void kernelClockCheck(long long ops) {
+    long long i, total = 0;
+    int maxtime = INT_MAX;
+    clock_t timeStart = clock(), timeElapsed;
+    for (i = 0; i < ops; i++) {
+        // Same check as the solvers' loops
+        timeElapsed = clock() - timeStart;
+        if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= maxtime) {
+            total++;
+        }
+    }
+    sink = total;
+}
+
+static void kernelBoardInit(long long ops) {
+    long long i, total = 0;
+    for (i = 0; i < ops; i++) {
+        randomBoard(boardSize);
+        total += board[0].y;
+    }
+    sink = total;
+}
+
+/**
+ * @brief Helper function to measure a kernel.
+ *
+ * Doubles the operations of a batch until it takes BATCH_NSECS, then
+ * measures REPETITIONS batches and keeps their medians.
+ */
+static Result measure(const char *name, void (*kernel)(long long)) {
+    Result result;
+    double ns[REPETITIONS], deviation[REPETITIONS], cycles[REPETITIONS], start, tmp;
+    unsigned long long cycleStart;
+    long long ops = 1;
+    int i, j;
+
+    // Calibrate batch size (also warms up caches and branch predictors)
+    for (;;) {
+        start = nowNsecs();
+        kernel(ops);
+        if (nowNsecs() - start >= BATCH_NSECS || ops >= (1LL << 40))
+            break;
+        ops *= 2;
+    }
+
+    for (i = 0; i < REPETITIONS; i++) {
+        start = nowNsecs();
+        cycleStart = nowCycles();
+        kernel(ops);
+        cycles[i] = (double) (nowCycles() - cycleStart) / ops;
+        ns[i] = (nowNsecs() - start) / ops;
+    }
+
+    // Insertion sorts, repetitions are few
+    for (i = 1; i < REPETITIONS; i++) {
+        for (j = i; j > 0 && ns[j - 1] > ns[j]; j--) {
+            tmp = ns[j]; ns[j] = ns[j - 1]; ns[j - 1] = tmp;
+        }
+        for (j = i; j > 0 && cycles[j - 1] > cycles[j]; j--) {
+            tmp = cycles[j]; cycles[j] = cycles[j - 1]; cycles[j - 1] = tmp;
+        }
+    }
+    result.nsPerOp = ns[REPETITIONS / 2];
+    result.cyclesPerOp = HAS_TSC ? cycles[REPETITIONS / 2] : -1;
+
+    for (i = 0; i < REPETITIONS; i++) {
+        deviation[i] = fabs(ns[i] - result.nsPerOp);
+    }
+    for (i = 1; i < REPETITIONS; i++) {
+        for (j = i; j > 0 && deviation[j - 1] > deviation[j]; j--) {
+            tmp = deviation[j]; deviation[j] = deviation[j - 1]; deviation[j - 1] = tmp;
+        }
+    }
+    result.spread = 100 * deviation[REPETITIONS / 2] / result.nsPerOp;
+
+    strncpy(result.name, name, NAME_LENGTH - 1);
+    result.name[NAME_LENGTH - 1] = '\0';
+    return result;
+}
+
+/**
+ * @brief Helper function to find the baseline ns/op of a kernel.
+ * @return Returns the baseline ns/op or -1 if the kernel isn't in the file.
+ */
+static double baselineOf(FILE *fp, const char *name) {
+    char line[128], kernel[NAME_LENGTH];
+    double nsPerOp;
+
+    rewind(fp);
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        if (line[0] == '#')
+            continue;
+        if (sscanf(line, "%31s %lf", kernel, &nsPerOp) == 2 && strcmp(kernel, name) == 0)
+            return nsPerOp;
+    }
+    return -1;
+}
+
+/**
+ * @brief Main function used to run the microbenchmarks.
+ *
+ * @param  argc Argument count
+ * @param  argv Arguments array in string form
+ * @return      Returns EXIT_FAILURE for wrong inputs or a regression else EXIT_SUCCESS.
+ */
+int main(int argc, char *argv[]) {
+    char *baselinePath = "bench/baseline.txt", *writePath = NULL, *convP;
+    double threshold = 25, base;
+    int i, regressions = 0, kernelAmount = 0;
+    int sizes[] = {8, 32, 128};
+    char name[NAME_LENGTH];
+    Result results[MAX_KERNELS];
+
+    if (argc % 2 == 0) {
+        printf("Arguments must come in pairs! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    for (i = 1; i < argc; i += 2) {
+        if (strcmp(argv[i], "baseline") == 0) {
+            baselinePath = argv[i+1];
+        }
+        else if (strcmp(argv[i], "threshold") == 0) {
+            threshold = strtod(argv[i+1], &convP);
+            if (*convP != '\0' || threshold < 0) {
+                printf("Threshold must be a non-negative percentage! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "write") == 0) {
+            writePath = argv[i+1];
+        }
+        else {
+            printf("Wrong argument or bad pair of arguments! Exiting...\n");
+            return EXIT_FAILURE;
+        }
+    }
+
+    srand(1);
+    board = malloc(128 * sizeof(Point));
+    initStack(&stack);
+
+    for (i = 0; i < 3; i++) {
+        randomBoard(sizes[i]);
+        sprintf(name, "countThreats/%d", sizes[i]);
+        results[kernelAmount++] = measure(name, kernelCountThreats);
+    }
+    randomBoard(32);
+    results[kernelAmount++] = measure("pushPop/32", kernelPushPop);
+    results[kernelAmount++] = measure("rand", kernelRand);
+    results[kernelAmount++] = measure("clockCheck", kernelClockCheck);
+    randomBoard(128);
+    results[kernelAmount++] = measure("boardInit/128", kernelBoardInit);
+
+    FILE *fp = fopen(baselinePath, "r");
+    if (fp == NULL) {
+        printf("Baseline file %s can't be read, results aren't compared.\n\n", baselinePath);
+    }
+
+    printf("%-18s %12s %10s %12s %12s\n", "kernel", "ns/op", "spread", "cycles/op", "baseline");
+    for (i = 0; i < kernelAmount; i++) {
+        base = (fp != NULL) ? baselineOf(fp, results[i].name) : -1;
+        printf("%-18s %12.2f %9.1f%% ", results[i].name, results[i].nsPerOp, results[i].spread);
+        if (results[i].cyclesPerOp >= 0)
+            printf("%12.1f ", results[i].cyclesPerOp);
+        else
+            printf("%12s ", "n/a");
+        if (base > 0) {
+            printf("%12.2f %+7.1f%%", base, 100 * (results[i].nsPerOp / base - 1));
+            if (results[i].nsPerOp > base * (1 + threshold / 100)) {
+                printf("  REGRESSED");
+                regressions++;
+            }
+        }
+        printf("\n");
+    }
+    if (fp != NULL)
+        fclose(fp);
+
+    if (writePath != NULL) {
+        fp = fopen(writePath, "w");
+        if (fp == NULL) {
+            printf("Baseline file %s can't be written! Exiting...\n", writePath);
+            return EXIT_FAILURE;
+        }
+        fprintf(fp, "# kernel ns/op (regenerate with 'make bench-baseline')\n");
+        for (i = 0; i < kernelAmount; i++) {
+            fprintf(fp, "%s %.2f\n", results[i].name, results[i].nsPerOp);
+        }
+        fclose(fp);
+        printf("\nBaseline written to %s\n", writePath);
+    }
+
+    free(board);
+    free(stack);
+
+    if (regressions > 0) {
+        printf("\n%d kernel(s) regressed more than %.1f%%\n", regressions, threshold);
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
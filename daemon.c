@@ -0,0 +1,443 @@
+/**
+ * @file daemon.c
+ * @brief Implements functions of daemon.h file.
+ */
+
+#include "daemon.h"
+#include "algorithms.h"
+#include "util.h"
+#include <pthread.h>	// for threads
+#include <signal.h>	// for sigaction
+#include <poll.h>	// for poll
+#include <unistd.h>	// for close, unlink
+#include <sys/socket.h>	// for sockets
+#include <sys/un.h>	// for sockaddr_un
+#include <sys/stat.h>	// for stat
+#include <sys/time.h>	// for timeval
+
+#define LATENCY_WINDOW 1024 // Solve requests kept for the latency percentiles
+
+/**
+ * @brief Solve request waiting for a worker.
+ */
+typedef struct {
+    int fd;                    // Connection to reply on
+    DaemonRequest request;
+    struct timespec received;  // When the request was read
+} Job;
+
+/**
+ * @brief Scratch boards of a worker, allocated for maxN.
+ */
+typedef struct {
+    Permutation board;    // Boards of the local searches, also used by backtracking
+    int *cols;            // Queens on every column (dfs)
+    unsigned char *reply; // Reply header and columns
+} Workspace;
+
+/**
+ * @brief Data shared by the accepting thread and the workers.
+ */
+typedef struct {
+    int maxN, maxtime, workers;
+    pthread_mutex_t lock;      // Guards everything below
+    pthread_cond_t notEmpty;
+    Job *queue;
+    size_t queueSize, head, count;
+    int stop;
+    uint64_t busy, served, expired, rejected;
+    uint32_t latencies[LATENCY_WINDOW];
+    uint64_t latencyCount;
+} Daemon;
+
+/**
+ * @brief Worker thread argument.
+ */
+typedef struct {
+    Daemon *shared;
+    Workspace space;
+} Worker;
+
+static volatile sig_atomic_t stopSignal = 0;
+
+/**
+ * @brief Signal handler that asks the accepting loop to stop.
+ */
+static void handleStop(int signal) {
+    (void) signal;
+    stopSignal = 1;
+}
+
+/**
+ * @brief Helper function to send all of a buffer, dropping it if the client left.
+ */
+static void sendAll(int fd, const void *buffer, size_t length) {
+    const unsigned char *bytes = buffer;
+    ssize_t sent;
+
+    while (length > 0) {
+        sent = send(fd, bytes, length, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return;
+        }
+        bytes += sent;
+        length -= sent;
+    }
+}
+
+/**
+ * @brief Helper function to reply to a solve request without columns.
+ */
+static void replyStatus(int fd, DaemonStatus status, uint32_t micros) {
+    DaemonReply reply;
+
+    memset(&reply, 0, sizeof(DaemonReply));
+    reply.status = status;
+    reply.micros = micros;
+    sendAll(fd, &reply, sizeof(DaemonReply));
+}
+
+/**
+ * @brief Backtracking on the scratch boards, row by row in column order.
+ */
+static DaemonStatus solveBacktrack(Workspace *w, int N, struct timespec *deadline) {
+    int row = 0, c;
+    long long steps = 0;
+
+    memset(w->cols, 0, N * sizeof(int));
+    memset(w->board.diags, 0, (2 * N - 1) * sizeof(int));
+    memset(w->board.antis, 0, (2 * N - 1) * sizeof(int));
+    w->board.colOf[0] = -1;
+
+    while (row >= 0) {
+        if (++steps % CHECK_STEPS == 0 && isExpired(deadline)) {
+            return DAEMON_EXPIRED;
+        }
+        // Lift the row's queen and try the next free column
+        c = w->board.colOf[row];
+        if (c >= 0) {
+            w->cols[c] = w->board.diags[row + c] = w->board.antis[row - c + N - 1] = 0;
+        }
+        for (c++; c < N && (w->cols[c] || w->board.diags[row + c] || w->board.antis[row - c + N - 1]); c++)
+            ;
+        if (c == N) {
+            row--; // Backtrack
+            continue;
+        }
+        w->cols[c] = w->board.diags[row + c] = w->board.antis[row - c + N - 1] = 1;
+        w->board.colOf[row] = c;
+        if (row == N - 1) {
+            return DAEMON_SOLVED;
+        }
+        w->board.colOf[++row] = -1;
+    }
+
+    return DAEMON_NO_SOLUTION;
+}
+
+/**
+ * @brief Helper function to record the latency of a solve request, with the lock held.
+ */
+static void recordLatency(Daemon *d, uint32_t micros) {
+    d->latencies[d->latencyCount % LATENCY_WINDOW] = micros;
+    d->latencyCount++;
+}
+
+/**
+ * @brief Helper function to compare latencies for qsort.
+ */
+static int compareLatencies(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *) a, y = *(const uint32_t *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Helper function to fill the stats of the daemon, percentiles from a sorted copy.
+ */
+static void collectStats(Daemon *d, DaemonStats *stats) {
+    uint32_t sorted[LATENCY_WINDOW];
+    size_t n;
+
+    memset(stats, 0, sizeof(DaemonStats));
+    pthread_mutex_lock(&d->lock);
+    stats->workers = d->workers;
+    stats->busy = d->busy;
+    stats->queueDepth = d->count;
+    stats->served = d->served;
+    stats->expired = d->expired;
+    stats->rejected = d->rejected;
+    n = (d->latencyCount < LATENCY_WINDOW) ? d->latencyCount : LATENCY_WINDOW;
+    memcpy(sorted, d->latencies, n * sizeof(uint32_t));
+    pthread_mutex_unlock(&d->lock);
+
+    if (n > 0) {
+        qsort(sorted, n, sizeof(uint32_t), compareLatencies);
+        stats->p50 = sorted[(n - 1) * 50 / 100];
+        stats->p90 = sorted[(n - 1) * 90 / 100];
+        stats->p99 = sorted[(n - 1) * 99 / 100];
+        stats->max = sorted[n - 1];
+    }
+}
+
+/**
+ * @brief Worker thread loop, solves requests from the queue until the daemon stops.
+ */
+static void *runWorker(void *arg) {
+    Worker *worker = arg;
+    Daemon *d = worker->shared;
+    Workspace *w = &worker->space;
+    DaemonReply *reply = (DaemonReply *) w->reply;
+    uint32_t *columns = (uint32_t *) (w->reply + sizeof(DaemonReply));
+    struct timespec deadline;
+    DaemonStatus status;
+    Job job;
+    int N, i, restartsCount, movesMade;
+
+    for (;;) {
+        pthread_mutex_lock(&d->lock);
+        while (d->count == 0 && !d->stop) {
+            pthread_cond_wait(&d->notEmpty, &d->lock);
+        }
+        if (d->count == 0) {
+            pthread_mutex_unlock(&d->lock);
+            break; // Stopped and drained
+        }
+        job = d->queue[d->head];
+        d->head = (d->head + 1) % d->queueSize;
+        d->count--;
+        d->busy++;
+        pthread_mutex_unlock(&d->lock);
+
+        N = job.request.N;
+        deadline = deadlineAfter(&job.received, job.request.budgetMs);
+        w->board.N = N;
+        w->board.rng = seedRandom(job.request.seed);
+
+        if (isExpired(&deadline)) {
+            status = DAEMON_EXPIRED; // Waited too long in the queue
+        }
+        else if (job.request.algorithm == DAEMON_DFS) {
+            status = solveBacktrack(w, N, &deadline);
+        }
+        else if (N <= 3) {
+            // Permutations of 2 and 3 queens always have threats
+            status = (N == 1) ? solveBacktrack(w, N, &deadline) : DAEMON_NO_SOLUTION;
+        }
+        else if (job.request.algorithm == DAEMON_HILL) {
+            // Same search as 'hill N space perm' with the default policy
+            status = hillPermutation(&w->board, &deadline, NULL, NULL, &restartsCount, &movesMade)
+                     ? DAEMON_SOLVED : DAEMON_EXPIRED;
+        }
+        else {
+            status = annPermutation(&w->board, &deadline, &movesMade) ? DAEMON_SOLVED : DAEMON_EXPIRED;
+        }
+
+        memset(reply, 0, sizeof(DaemonReply));
+        reply->status = status;
+        reply->micros = nanosSince(&job.received) / 1000;
+        if (status == DAEMON_SOLVED) {
+            reply->N = N;
+            for (i = 0; i < N; i++) {
+                columns[i] = w->board.colOf[i];
+            }
+        }
+        sendAll(job.fd, w->reply, sizeof(DaemonReply) + reply->N * sizeof(uint32_t));
+        close(job.fd);
+
+        pthread_mutex_lock(&d->lock);
+        d->busy--;
+        d->served++;
+        d->expired += (status == DAEMON_EXPIRED);
+        recordLatency(d, reply->micros);
+        pthread_mutex_unlock(&d->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function to read a request and answer it or queue it.
+ */
+static void handleConnection(Daemon *d, int fd) {
+    DaemonRequest request;
+    DaemonStats stats;
+    struct timeval timeout = {1, 0};
+    Job job;
+
+    // Don't let a silent client hold up the accepting loop
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    if (recv(fd, &request, sizeof(DaemonRequest), MSG_WAITALL) != sizeof(DaemonRequest)) {
+        close(fd);
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &job.received);
+
+    if (request.type == DAEMON_REQUEST_STATS) {
+        collectStats(d, &stats);
+        sendAll(fd, &stats, sizeof(DaemonStats));
+        close(fd);
+        return;
+    }
+
+    if (request.budgetMs == 0) {
+        request.budgetMs = (uint32_t) d->maxtime * 1000;
+    }
+    pthread_mutex_lock(&d->lock);
+    if (request.type != DAEMON_REQUEST_SOLVE || request.algorithm >= DAEMON_ALGORITHMS
+        || request.N < 1 || request.N > (uint32_t) d->maxN
+        || request.budgetMs > (uint32_t) d->maxtime * 1000 || d->count == d->queueSize) {
+        d->rejected++;
+        pthread_mutex_unlock(&d->lock);
+        replyStatus(fd, DAEMON_REJECTED, nanosSince(&job.received) / 1000);
+        close(fd);
+        return;
+    }
+    job.fd = fd;
+    job.request = request;
+    d->queue[(d->head + d->count) % d->queueSize] = job;
+    d->count++;
+    pthread_cond_signal(&d->notEmpty);
+    pthread_mutex_unlock(&d->lock);
+}
+
+/**
+ * @brief Helper function to free the scratch boards of the workers.
+ */
+static void freeWorkers(Worker *workers, int amount) {
+    int i;
+
+    for (i = 0; i < amount; i++) {
+        free(workers[i].space.board.colOf);
+        free(workers[i].space.cols);
+        free(workers[i].space.board.diags);
+        free(workers[i].space.board.antis);
+        free(workers[i].space.board.rows);
+        free(workers[i].space.reply);
+    }
+    free(workers);
+}
+
+int runDaemon(const char *socketPath, int workers, int maxN, int maxtime, size_t queueSize, FILE *log) {
+    // Deadlines up to maxtime must fit the 32-bit milliseconds of a request
+    if (socketPath == NULL || workers <= 0 || maxN <= 0 || maxtime <= 0 || (uint32_t) maxtime > UINT32_MAX / 1000
+        || queueSize == 0
+        || strlen(socketPath) >= sizeof(((struct sockaddr_un *) NULL)->sun_path)) {
+        return EXIT_FAILURE;
+    }
+
+    Daemon d;
+    Worker *pool = calloc(workers, sizeof(Worker));
+    pthread_t *threads = malloc(workers * sizeof(pthread_t));
+    struct sockaddr_un address;
+    struct sigaction action;
+    struct pollfd listener;
+    struct stat info;
+    int listenFd, fd, i, started, status = EXIT_SUCCESS;
+
+    memset(&d, 0, sizeof(Daemon));
+    d.maxN = maxN;
+    d.maxtime = maxtime;
+    d.workers = workers;
+    d.queueSize = queueSize;
+    d.queue = malloc(queueSize * sizeof(Job));
+    if (pool == NULL || threads == NULL || d.queue == NULL) {
+        free(pool);
+        free(threads);
+        free(d.queue);
+        return EXIT_FAILURE;
+    }
+    // Scratch boards for the largest N, so requests never allocate
+    for (i = 0; i < workers; i++) {
+        pool[i].shared = &d;
+        pool[i].space.board.colOf = malloc(maxN * sizeof(int));
+        pool[i].space.cols = malloc(maxN * sizeof(int));
+        pool[i].space.board.diags = malloc((2 * maxN - 1) * sizeof(int));
+        pool[i].space.board.antis = malloc((2 * maxN - 1) * sizeof(int));
+        pool[i].space.board.rows = malloc(maxN * sizeof(int));
+        pool[i].space.board.publish = 0; // Workers would contend on the shared counters
+        pool[i].space.reply = malloc(sizeof(DaemonReply) + maxN * sizeof(uint32_t));
+        if (pool[i].space.board.colOf == NULL || pool[i].space.cols == NULL || pool[i].space.board.diags == NULL
+            || pool[i].space.board.antis == NULL || pool[i].space.board.rows == NULL || pool[i].space.reply == NULL) {
+            freeWorkers(pool, workers);
+            free(threads);
+            free(d.queue);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Replace a stale socket, but nothing else
+    if (stat(socketPath, &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(socketPath);
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || bind(listenFd, (struct sockaddr *) &address, sizeof(address)) != 0
+        || listen(listenFd, 64) != 0) {
+        if (listenFd >= 0) {
+            close(listenFd);
+        }
+        freeWorkers(pool, workers);
+        free(threads);
+        free(d.queue);
+        return EXIT_FAILURE;
+    }
+
+    pthread_mutex_init(&d.lock, NULL);
+    pthread_cond_init(&d.notEmpty, NULL);
+    for (started = 0; started < workers; started++) {
+        if (pthread_create(&threads[started], NULL, runWorker, &pool[started]) != 0) {
+            status = EXIT_FAILURE;
+            break;
+        }
+    }
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = handleStop;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    stopSignal = 0;
+    if (status == EXIT_SUCCESS && log != NULL) {
+        fprintf(log, "Daemon listening on %s with %d workers (N up to %d, deadlines up to %d secs)\n",
+                socketPath, workers, maxN, maxtime);
+        fflush(log);
+    }
+
+    // Accept until a signal, polling so the stop flag is seen
+    listener.fd = listenFd;
+    listener.events = POLLIN;
+    while (status == EXIT_SUCCESS && !stopSignal) {
+        if (poll(&listener, 1, 200) <= 0) {
+            continue;
+        }
+        fd = accept(listenFd, NULL, NULL);
+        if (fd >= 0) {
+            handleConnection(&d, fd);
+        }
+    }
+
+    // Workers drain the queue, its deadlines bound the wait
+    pthread_mutex_lock(&d.lock);
+    d.stop = 1;
+    pthread_cond_broadcast(&d.notEmpty);
+    pthread_mutex_unlock(&d.lock);
+    for (i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    close(listenFd);
+    unlink(socketPath);
+
+    if (log != NULL) {
+        fprintf(log, "Daemon stopped: %llu served (%llu expired), %llu rejected\n",
+                (unsigned long long) d.served, (unsigned long long) d.expired, (unsigned long long) d.rejected);
+    }
+    pthread_mutex_destroy(&d.lock);
+    pthread_cond_destroy(&d.notEmpty);
+    freeWorkers(pool, workers);
+    free(threads);
+    free(d.queue);
+
+    return status;
+}
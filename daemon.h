@@ -0,0 +1,86 @@
+/**
+ *@file daemon.h
+ *@brief Resident solver daemon serving requests over a Unix domain socket.
+ *
+ * This file includes the wire format and the function prototype of a daemon
+ * that keeps a pool of worker threads running, each with scratch boards
+ * allocated once for the largest N served, so requests don't pay process
+ * start and allocation costs.
+ *
+ * A client connects to the socket, sends one DaemonRequest (16 bytes in
+ * native byte order), reads the reply and the connection is closed:
+ * a solve request gets a DaemonReply followed by N 32-bit columns of the
+ * queens of rows 0..N-1 if solved, a stats request gets a DaemonStats.
+ */
+
+#ifndef DAEMON_H
+#define DAEMON_H
+#include "def.h"
+#include <stdint.h>	// for fixed width integers of the wire format
+
+#define DAEMON_REQUEST_SOLVE 1
+#define DAEMON_REQUEST_STATS 2
+
+typedef enum {
+	DAEMON_DFS,        // Backtracking, finds a solution or proves there's none
+	DAEMON_HILL,       // Hill climbing over permutations, as 'hill N space perm'
+	DAEMON_ANN,        // Annealing over permutations, as 'ann N space perm'
+	DAEMON_ALGORITHMS
+} DaemonAlgorithm;
+
+typedef enum {
+	DAEMON_SOLVED,      // Columns follow the reply
+	DAEMON_NO_SOLUTION, // Exhaustive search found none
+	DAEMON_EXPIRED,     // Deadline passed, in the queue or while solving
+	DAEMON_REJECTED     // Invalid request or queue full
+} DaemonStatus;
+
+typedef struct {
+	uint8_t type;      // DAEMON_REQUEST_SOLVE or DAEMON_REQUEST_STATS
+	uint8_t algorithm; // DaemonAlgorithm of a solve request
+	uint16_t reserved;
+	uint32_t N;        // Amount of queens
+	uint32_t seed;     // Seed of the randomized algorithms
+	uint32_t budgetMs; // Deadline in ms from when the daemon receives it (0 for maxtime)
+} DaemonRequest;
+
+typedef struct {
+	int32_t status;    // DaemonStatus
+	uint32_t N;        // Columns that follow (N if solved else 0)
+	uint32_t micros;   // Time from receipt to reply
+	uint32_t reserved;
+} DaemonReply;
+
+typedef struct {
+	uint64_t workers;    // Threads of the pool
+	uint64_t busy;       // Workers solving a request
+	uint64_t queueDepth; // Requests waiting for a worker
+	uint64_t served;     // Solve requests answered by workers
+	uint64_t expired;    // Of them, deadlines that passed
+	uint64_t rejected;   // Invalid requests or queue full
+	uint64_t p50, p90, p99, max; // Latency of recent solve requests in microseconds
+} DaemonStats;
+
+/**
+ * @brief Function that runs the solver daemon until SIGINT or SIGTERM.
+ *
+ * This function listens on a Unix stream socket at socketPath (a stale
+ * socket there is replaced) and starts workers threads. The calling thread
+ * accepts connections and reads their requests: stats requests are answered
+ * right away, solve requests are checked and put in a queue of queueSize
+ * requests, which the workers take in order. A request whose deadline
+ * passes in the queue is answered expired without being solved, and solvers
+ * stop at the deadline. Latency percentiles are kept for the last 1024
+ * solve requests. Events are printed to log (if not null).
+ *
+ * @param  socketPath Path of the socket.
+ * @param  workers    Amount of worker threads.
+ * @param  maxN       Largest N served, scratch boards are allocated for it.
+ * @param  maxtime    Largest deadline in seconds (up to UINT32_MAX / 1000), and the one of requests without it.
+ * @param  queueSize  Requests waiting for a worker before new ones are rejected.
+ * @param  log        Stream to print events to, or null.
+ * @return            EXIT_FAILURE if the socket, memory, or threads can't be set up else EXIT_SUCCESS
+ */
+int runDaemon(const char *socketPath, int workers, int maxN, int maxtime, size_t queueSize, FILE *log);
+
+#endif
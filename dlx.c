@@ -0,0 +1,285 @@
+/**
+ * @file dlx.c
+ * @brief Implements functions of dlx.h file.
+ */
+
+#include "dlx.h"
+#include "telemetry.h"
+
+/**
+ * @brief Helper function to get the first node of the option of cell (row, col).
+ */
+static int optionNode(DLX *dlx, int row, int col) {
+    return dlx->itemAmount + 1 + 4 * (row * dlx->N + col);
+}
+
+/**
+ * @brief Helper function to cover an item.
+ *
+ * Removes the item from the active item list and hides every other
+ * option that contains it from the lists of their other items.
+ */
+static void cover(DLX *dlx, int item) {
+    DLXNode *n = dlx->nodes;
+    int p, q;
+
+    n[n[item].right].left = n[item].left;
+    n[n[item].left].right = n[item].right;
+    for (p = n[item].down; p != item; p = n[p].down) {
+        for (q = n[p].right; q != p; q = n[q].right) {
+            n[n[q].down].up = n[q].up;
+            n[n[q].up].down = n[q].down;
+            n[n[q].top].top--;
+            dlx->updates++;
+        }
+    }
+}
+
+/**
+ * @brief Helper function to uncover an item (exact reverse of cover).
+ */
+static void uncover(DLX *dlx, int item) {
+    DLXNode *n = dlx->nodes;
+    int p, q;
+
+    for (p = n[item].up; p != item; p = n[p].up) {
+        for (q = n[p].left; q != p; q = n[q].left) {
+            n[n[q].top].top++;
+            n[n[q].down].up = q;
+            n[n[q].up].down = q;
+        }
+    }
+    n[n[item].right].left = item;
+    n[n[item].left].right = item;
+}
+
+int initDLX(DLX **dlx, int N) {
+    if (dlx == NULL || N <= 0)
+        return EXIT_FAILURE;
+
+    *dlx = (DLX *) malloc(sizeof(DLX));
+    if (*dlx == NULL)
+        return EXIT_FAILURE;
+
+    DLX *d = *dlx;
+    d->N = N;
+    d->itemAmount = 2 * N + 2 * (2 * N - 1);
+    d->nodes = (DLXNode *) malloc((d->itemAmount + 1 + 4 * (size_t) N * N) * sizeof(DLXNode));
+    d->colOf = (int *) malloc(N * sizeof(int));
+    d->itemTaken = (char *) calloc(d->itemAmount + 1, sizeof(char));
+    if (d->nodes == NULL || d->colOf == NULL || d->itemTaken == NULL) {
+        freeDLX(d);
+        *dlx = NULL;
+        return EXIT_FAILURE;
+    }
+    d->presetAmount = 0;
+    d->solutions = 0;
+    d->updates = 0;
+    d->timeExpired = 0;
+
+    DLXNode *n = d->nodes;
+    int i, k, row, col, line, last, x;
+    int items[4];
+
+    // Every header starts as an empty item that is linked only to itself
+    for (i = 0; i <= d->itemAmount; i++) {
+        n[i].left = n[i].right = n[i].up = n[i].down = i;
+        n[i].top = 0;
+    }
+
+    // Link the primary items (row, then column) from the middle line outwards
+    last = 0;
+    for (k = 0; k < N; k++) {
+        line = (k % 2 == 1) ? N / 2 - (k + 1) / 2 : N / 2 + (k + 1) / 2;
+        for (i = 0; i < 2; i++) {
+            x = 1 + line + i * N;
+            n[x].left = last;
+            n[last].right = x;
+            last = x;
+        }
+    }
+    n[last].right = 0;
+    n[0].left = last;
+
+    // Append the option of each cell to the bottom of its 4 items
+    for (row = 0; row < N; row++) {
+        d->colOf[row] = -1;
+        for (col = 0; col < N; col++) {
+            items[0] = 1 + row;                                 // Row
+            items[1] = 1 + N + col;                             // Column
+            items[2] = 1 + 2 * N + row + col;                   // Diagonal
+            items[3] = 1 + 2 * N + (2 * N - 1) + row - col + N - 1; // Anti-diagonal
+            x = optionNode(d, row, col);
+            for (i = 0; i < 4; i++) {
+                n[x + i].left = x + (i + 3) % 4;
+                n[x + i].right = x + (i + 1) % 4;
+                n[x + i].top = items[i];
+                n[x + i].up = n[items[i]].up;
+                n[x + i].down = items[i];
+                n[n[items[i]].up].down = x + i;
+                n[items[i]].up = x + i;
+                n[items[i]].top++;
+            }
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int placeQueenDLX(DLX *dlx, int row, int col) {
+    if (dlx == NULL || row < 0 || row >= dlx->N || col < 0 || col >= dlx->N)
+        return EXIT_FAILURE;
+
+    int i, x = optionNode(dlx, row, col);
+
+    // Queen threatens (or is on the same cell as) a pre-placed queen
+    for (i = 0; i < 4; i++) {
+        if (dlx->itemTaken[dlx->nodes[x + i].top])
+            return EXIT_FAILURE;
+    }
+
+    for (i = 0; i < 4; i++) {
+        dlx->itemTaken[dlx->nodes[x + i].top] = 1;
+        cover(dlx, dlx->nodes[x + i].top);
+    }
+    dlx->colOf[row] = col;
+    dlx->presetAmount++;
+
+    return EXIT_SUCCESS;
+}
+
+int loadPresetDLX(DLX *dlx, const char *path) {
+    if (dlx == NULL || path == NULL)
+        return EXIT_FAILURE;
+
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL)
+        return EXIT_FAILURE;
+
+    char line[256], extra;
+    int row, col, fields, status = EXIT_SUCCESS;
+    while (fgets(line, sizeof(line), fp) != NULL) {
+        fields = sscanf(line, " %d %d %c", &row, &col, &extra);
+        // Skip empty lines and comments
+        if (fields == EOF || (fields == 0 && line[strspn(line, " \t")] == '#'))
+            continue;
+        if (fields != 2 || placeQueenDLX(dlx, row, col) == EXIT_FAILURE) {
+            status = EXIT_FAILURE;
+            break;
+        }
+    }
+    fclose(fp);
+
+    return status;
+}
+
+Point *solveDLX(DLX *dlx, int maxtime, int countAll) {
+    if (dlx == NULL)
+        return NULL;
+
+    DLXNode *n = dlx->nodes;
+    int N = dlx->N, levels = N - dlx->presetAmount;
+    int *choice = malloc((levels + 1) * sizeof(int)); // Option node chosen at each level
+    int *itemAt = malloc((levels + 1) * sizeof(int)); // Item covered at each level
+    Point *solution = NULL;
+
+    int level = 0, item, len, p, cell, i;
+    long long nodesExpanded = 0; // Levels entered, published as progress
+    clock_t timeStart = clock(), timeElapsed; // Time counter
+
+    dlx->solutions = 0;
+    dlx->updates = 0;
+    dlx->timeExpired = 0;
+
+    enter_level:
+    PUBLISH_PROGRESS(nodes, ++nodesExpanded);
+    PUBLISH_PROGRESS(depth, level);
+    // Check time interval
+    timeElapsed = clock() - timeStart;
+    if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= maxtime) {
+        dlx->timeExpired = 1;
+        goto unwind;
+    }
+
+    // All primary items covered, solution found
+    if (n[0].right == 0) {
+        dlx->solutions++;
+        if (solution == NULL) {
+            solution = malloc(N * sizeof(Point));
+            for (i = 0; i < N; i++) {
+                solution[i].x = i;
+                solution[i].y = dlx->colOf[i];
+            }
+            for (i = 0; i < level; i++) {
+                cell = (choice[i] - dlx->itemAmount - 1) / 4;
+                solution[cell / N].y = cell % N;
+            }
+        }
+        if (!countAll) {
+            goto unwind;
+        }
+        goto backtrack;
+    }
+
+    // Choose the primary item with the fewest options
+    item = n[0].right;
+    len = n[item].top;
+    for (p = n[item].right; p != 0 && len > 0; p = n[p].right) {
+        if (n[p].top < len) {
+            item = p;
+            len = n[p].top;
+        }
+    }
+    cover(dlx, item);
+    itemAt[level] = item;
+    choice[level] = n[item].down;
+
+    try_option:
+    // Options of the item exhausted
+    if (choice[level] == itemAt[level]) {
+        uncover(dlx, itemAt[level]);
+        goto backtrack;
+    }
+    for (p = n[choice[level]].right; p != choice[level]; p = n[p].right) {
+        cover(dlx, n[p].top);
+    }
+    level++;
+    goto enter_level;
+
+    backtrack:
+    if (level == 0) {
+        goto finish;
+    }
+    level--;
+    for (p = n[choice[level]].left; p != choice[level]; p = n[p].left) {
+        uncover(dlx, n[p].top);
+    }
+    choice[level] = n[choice[level]].down;
+    goto try_option;
+
+    unwind:
+    // Restore the links of the levels still covered so the engine can be reused
+    while (level > 0) {
+        level--;
+        for (p = n[choice[level]].left; p != choice[level]; p = n[p].left) {
+            uncover(dlx, n[p].top);
+        }
+        uncover(dlx, itemAt[level]);
+    }
+
+    finish:
+    free(choice);
+    free(itemAt);
+
+    return solution;
+}
+
+void freeDLX(DLX *dlx) {
+    if (dlx == NULL)
+        return;
+
+    free(dlx->nodes);
+    free(dlx->colOf);
+    free(dlx->itemTaken);
+    free(dlx);
+}
@@ -0,0 +1,119 @@
+/**
+ *@file dlx.h
+ *@brief Dancing Links (Algorithm X) engine for the nQueens problem.
+ *
+ * This file includes function prototypes for an exact cover engine that
+ * solves nQueens completion instances, where some queens are pre-placed.
+ * Rows and columns of the board are primary items (covered exactly once),
+ * diagonals and anti-diagonals are secondary items (covered at most once).
+ * Every cell of the board is an option of 4 nodes, one for each of its items.
+ * All headers and nodes are preallocated in a single array.
+ * It uses the struct Point from def.h file.
+ */
+
+#ifndef DLX_H
+#define DLX_H
+#include "def.h"
+
+typedef struct {
+	int left;   // Left node in option (or active item list for headers)
+	int right;  // Right node in option (or active item list for headers)
+	int up;     // Node above in item
+	int down;   // Node below in item
+	int top;    // Item header of node (or option count for headers)
+} DLXNode;
+
+typedef struct {
+	int N;                // Amount of queens
+	int itemAmount;       // Amount of items (headers 1..itemAmount, root is 0)
+	DLXNode *nodes;       // Headers followed by N*N options of 4 nodes
+	int *colOf;           // Column of the queen in each row (-1 if none)
+	char *itemTaken;      // Items covered by pre-placed queens
+	int presetAmount;     // Amount of pre-placed queens
+	long long solutions;  // Solutions found by the last solve
+	long long updates;    // Node link updates made by the last solve
+	int timeExpired;      // 1 if the last solve ran out of time
+} DLX;
+
+/**
+ * @brief Function to initialize a Dancing Links engine for N queens.
+ *
+ * This function takes in a pointer to a DLX pointer and allocates the engine
+ * with all of its headers and nodes in a single array. The N rows and N columns
+ * are linked as primary items, starting from the middle of the board outwards
+ * so that ties on the smallest item are broken by the most constrained lines.
+ * The 2N-1 diagonals and 2N-1 anti-diagonals are secondary items.
+ * If malloc fails or N is not positive EXIT_FAILURE is returned.
+ *
+ * @param  dlx Pointer to DLX pointer
+ * @param  N   Amount of queens
+ * @return     EXIT_FAILURE or EXIT_SUCCESS
+ */
+int initDLX(DLX **dlx, int N);
+
+/**
+ * @brief Function to pre-place a queen before solving.
+ *
+ * This function selects the option of the cell (row, col) and covers
+ * its items, so the search only completes the remaining rows.
+ * If the cell is off the board or the queen threatens a pre-placed
+ * queen EXIT_FAILURE is returned and the engine is left unchanged.
+ *
+ * @param  dlx DLX engine
+ * @param  row Row of the queen
+ * @param  col Column of the queen
+ * @return     EXIT_FAILURE or EXIT_SUCCESS
+ */
+int placeQueenDLX(DLX *dlx, int row, int col);
+
+/**
+ * @brief Function to pre-place the queens listed in a file.
+ *
+ * The file holds one queen per line as a row and a column number
+ * (starting from 0) separated by whitespace. Empty lines and lines
+ * starting with '#' are skipped.
+ * If the file can't be read, a line is malformed, or a queen can't be
+ * placed (see placeQueenDLX) EXIT_FAILURE is returned.
+ *
+ * @param  dlx  DLX engine
+ * @param  path Path of the file
+ * @return      EXIT_FAILURE or EXIT_SUCCESS
+ */
+int loadPresetDLX(DLX *dlx, const char *path);
+
+/**
+ * @brief Function that uses Algorithm X with Dancing Links to solve the nQueens problem.
+ *
+ * This function searches for exact covers of the rows and columns that are
+ * not covered by pre-placed queens, while covering each diagonal at most once.
+ *
+ * The algorithm is the following:
+ * 1. If no primary item is left, a solution is found.
+ * a. In first mode return it.
+ * b. In count mode count it and backtrack.
+ * 2. Choose the primary item with the fewest options and cover it.
+ * 3. For each option of the item:
+ * a. Cover the other items of the option and go to step 1 for the next level.
+ * b. Uncover them when returning.
+ * 4. Uncover the item and backtrack to the previous level.
+ *
+ * The solutions found and node link updates are saved in the engine's
+ * solutions and updates fields, and timeExpired is set if the search
+ * was stopped by maxtime (in count mode the count is then partial).
+ * The engine can be solved again afterwards.
+ *
+ * @param  dlx      DLX engine with pre-placed queens
+ * @param  maxtime  Max time to spend running the algorithm.
+ * @param  countAll 0 to stop at the first solution, 1 to count all of them.
+ * @return          Returns the first solution array of points if found or null if not.
+ */
+Point *solveDLX(DLX *dlx, int maxtime, int countAll);
+
+/**
+ * @brief Function to free a Dancing Links engine.
+ *
+ * @param  dlx DLX engine (can be null)
+ */
+void freeDLX(DLX *dlx);
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * @file enumerate.c
+ * @brief Implements functions of enumerate.h file.
+ */
+
+#include "enumerate.h"
+
+#define TIME_CHECK_NODES 4096 // Queens placed between two time checks
+
+/**
+ * @brief Helper function to take or release the lines of the queen at (row, col).
+ */
+static void markQueen(SolutionIterator *it, int row, int col, char taken) {
+    it->cols[col] = taken;
+    it->diags[row + col] = taken;
+    it->antis[row - col + it->N - 1] = taken;
+}
+
+int initIterator(SolutionIterator **it, int N, int maxtime) {
+    if (it == NULL || N <= 0)
+        return EXIT_FAILURE;
+
+    *it = (SolutionIterator *) malloc(sizeof(SolutionIterator));
+    if (*it == NULL)
+        return EXIT_FAILURE;
+
+    SolutionIterator *s = *it;
+    s->N = N;
+    s->depth = 0;
+    s->colOf = (int *) malloc(N * sizeof(int));
+    s->nextCol = (int *) calloc(N, sizeof(int));
+    s->cols = (char *) calloc(N, sizeof(char));
+    s->diags = (char *) calloc(2 * N - 1, sizeof(char));
+    s->antis = (char *) calloc(2 * N - 1, sizeof(char));
+    s->solution = (Point *) malloc(N * sizeof(Point));
+    s->count = 0;
+    s->maxtime = maxtime;
+    s->timeStart = clock();
+    s->timeExpired = 0;
+    s->firstColEnd = N;
+    s->cancel = NULL;
+    if (s->colOf == NULL || s->nextCol == NULL || s->cols == NULL || s->diags == NULL
+        || s->antis == NULL || s->solution == NULL) {
+        freeIterator(s);
+        *it = NULL;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+const Point *nextSolution(SolutionIterator *it) {
+    if (it == NULL || it->depth < 0)
+        return NULL;
+
+    int N = it->N, row = it->depth, col, end, nodes = 0;
+    clock_t timeElapsed;
+
+    // Resuming after a solution, take back its last queen
+    if (it->count > 0 && row == N - 1) {
+        markQueen(it, row, it->colOf[row], 0);
+    }
+
+    while (row >= 0) {
+        // Check time interval
+        if (++nodes == TIME_CHECK_NODES) {
+            nodes = 0;
+            timeElapsed = clock() - it->timeStart;
+            if ((int) ((float) timeElapsed/CLOCKS_PER_SEC) >= it->maxtime
+                || (it->cancel != NULL && __atomic_load_n(it->cancel, __ATOMIC_RELAXED))) {
+                it->timeExpired = 1;
+                it->depth = -1;
+                return NULL;
+            }
+        }
+
+        // Find the next free column of the row
+        end = (row == 0) ? it->firstColEnd : N;
+        for (col = it->nextCol[row]; col < end; col++) {
+            if (!it->cols[col] && !it->diags[row + col] && !it->antis[row - col + N - 1])
+                break;
+        }
+
+        // Row exhausted, take back the previous row's queen
+        if (col == end) {
+            it->nextCol[row] = 0;
+            row--;
+            if (row >= 0)
+                markQueen(it, row, it->colOf[row], 0);
+            continue;
+        }
+
+        it->colOf[row] = col;
+        it->nextCol[row] = col + 1;
+        if (row == N - 1) {
+            // Solution found, leave it on the board to resume from
+            markQueen(it, row, col, 1);
+            for (col = 0; col < N; col++) {
+                it->solution[col].x = col;
+                it->solution[col].y = it->colOf[col];
+            }
+            it->depth = row;
+            it->count++;
+            return it->solution;
+        }
+        markQueen(it, row, col, 1);
+        row++;
+    }
+
+    it->depth = -1;
+    return NULL;
+}
+
+int restrictIterator(SolutionIterator *it, int firstCol) {
+    if (it == NULL || firstCol < 0 || firstCol >= it->N)
+        return EXIT_FAILURE;
+
+    int N = it->N;
+    memset(it->nextCol, 0, N * sizeof(int));
+    memset(it->cols, 0, N * sizeof(char));
+    memset(it->diags, 0, (2 * N - 1) * sizeof(char));
+    memset(it->antis, 0, (2 * N - 1) * sizeof(char));
+    it->depth = 0;
+    it->nextCol[0] = firstCol;
+    it->firstColEnd = firstCol + 1;
+
+    return EXIT_SUCCESS;
+}
+
+void freeIterator(SolutionIterator *it) {
+    if (it == NULL)
+        return;
+
+    free(it->colOf);
+    free(it->nextCol);
+    free(it->cols);
+    free(it->diags);
+    free(it->antis);
+    free(it->solution);
+    free(it);
+}
+
+long long enumerateSolutions(int N, int maxtime, SolutionCallback callback, void *context) {
+    SolutionIterator *it;
+    const Point *solution;
+    long long count = 0;
+
+    if (callback == NULL || initIterator(&it, N, maxtime) == EXIT_FAILURE)
+        return -1;
+
+    while ((solution = nextSolution(it)) != NULL) {
+        count++;
+        if (callback(solution, N, context))
+            break;
+    }
+    freeIterator(it);
+
+    return count;
+}
@@ -0,0 +1,112 @@
+/**
+ *@file enumerate.h
+ *@brief Streaming enumeration of all the solutions of the nQueens problem.
+ *
+ * This file includes function prototypes for an iterator that yields the
+ * solutions of the nQueens problem one at a time, as they are found by a
+ * resumable depth-first search, and a callback-per-solution wrapper of it.
+ * Solutions are yielded from a buffer owned by the iterator and reused for
+ * every solution, so enumeration makes no allocation per solution and the
+ * caller can stop at any point.
+ * It uses the struct Point from def.h file.
+ */
+
+#ifndef ENUMERATE_H
+#define ENUMERATE_H
+#include "def.h"
+
+typedef struct {
+	int N;                // Amount of queens
+	int depth;            // Row of the search (-1 when exhausted)
+	int *colOf;           // Column of the queen in each row up to depth
+	int *nextCol;         // Next column to try in each row
+	char *cols;           // Columns taken
+	char *diags;          // Diagonals taken (row + col)
+	char *antis;          // Anti-diagonals taken (row - col + N - 1)
+	Point *solution;      // Buffer the solutions are yielded from
+	long long count;      // Solutions yielded so far
+	int maxtime;          // Max time to spend enumerating
+	clock_t timeStart;    // Time the iterator was initialized
+	int timeExpired;      // 1 if the enumeration stopped because of maxtime or cancel
+	int firstColEnd;      // Columns of row 0 tried are below this (N by default)
+	int *cancel;          // Flag set by another thread to stop (null for none)
+} SolutionIterator;
+
+/**
+ * @brief Callback called for each solution by enumerateSolutions.
+ *
+ * The solution array (of N points, one per row) is only valid during
+ * the call, it's reused for the next solution.
+ * Returning non-zero stops the enumeration.
+ */
+typedef int (*SolutionCallback)(const Point *solution, int N, void *context);
+
+/**
+ * @brief Function to initialize a solution iterator.
+ *
+ * This function takes in a pointer to an iterator pointer and allocates
+ * the iterator with all the buffers the search needs, positioned before
+ * the first solution.
+ * If malloc fails or N is not positive EXIT_FAILURE is returned.
+ *
+ * @param  it      Pointer to iterator pointer
+ * @param  N       Amount of queens
+ * @param  maxtime Max time to spend enumerating
+ * @return         EXIT_FAILURE or EXIT_SUCCESS
+ */
+int initIterator(SolutionIterator **it, int N, int maxtime);
+
+/**
+ * @brief Function to get the next solution of an iterator.
+ *
+ * This function resumes the depth-first search from the last solution
+ * yielded (one queen per row, each row trying its columns in order) until
+ * the next solution is found.
+ * The returned array is the iterator's buffer, overwritten by the next call.
+ * If all solutions have been yielded, time has expired, or the cancel flag
+ * has been set null is returned (timeExpired tells these apart).
+ *
+ * @param  it Iterator
+ * @return    Returns the next solution array of points or null if there are no more.
+ */
+const Point *nextSolution(SolutionIterator *it);
+
+/**
+ * @brief Function to restrict an iterator to the solutions with a given first queen.
+ *
+ * This function rewinds the iterator and restricts it to the solutions where
+ * the queen of row 0 is at column firstCol, so that threads can split an
+ * enumeration by first column while each reusing its own iterator.
+ * The count of solutions yielded is kept.
+ * If firstCol is off the board EXIT_FAILURE is returned.
+ *
+ * @param  it       Iterator
+ * @param  firstCol Column of the queen of row 0
+ * @return          EXIT_FAILURE or EXIT_SUCCESS
+ */
+int restrictIterator(SolutionIterator *it, int firstCol);
+
+/**
+ * @brief Function to free a solution iterator.
+ *
+ * @param  it Iterator (can be null)
+ */
+void freeIterator(SolutionIterator *it);
+
+/**
+ * @brief Function to call a callback for every solution of the nQueens problem.
+ *
+ * This function iterates over the solutions with a SolutionIterator and
+ * passes each of them to callback, until there are no more solutions,
+ * time has expired, or callback returns non-zero.
+ * If the iterator can't be initialized -1 is returned.
+ *
+ * @param  N        Amount of queens.
+ * @param  maxtime  Max time to spend enumerating.
+ * @param  callback Function called for each solution.
+ * @param  context  Pointer passed to callback as is.
+ * @return          Returns the amount of solutions passed to callback, or -1.
+ */
+long long enumerateSolutions(int N, int maxtime, SolutionCallback callback, void *context);
+
+#endif
@@ -5,15 +5,188 @@
  * This program to solve the n Queens problem has the option of:
  * 1) DFS,
  * 2) hill climbing with restarts,
- * 3) simulated annealing
+ * 3) simulated annealing,
+ * 4) DFS with constraint propagation (minimum remaining values),
+ * 5) Dancing Links (Algorithm X), which can complete pre-placed queens,
+ * 6) parallel tempering (replica-exchange annealing across threads),
+ * 7) enumeration of all solutions, streamed as they are found,
+ * 8) automatic selection among 1-6 from a calibration table,
+ * 9) hill climbing on a batch of boards, one board per SIMD lane,
+ * 10) a daemon serving solve requests over a Unix socket
  * This problem requires the program to find a pattern of queens
  * where no queens are at threat from another queen on a given chessboard
  * size.
  * A time limit is set to the program and optionally a seed for the rand()
- * function for algorithms 2 and 3.
+ * function for algorithms 2, 3, 6, 8 and 9.
  */
 
 #include "algorithms.h"
+#include "dlx.h"
+#include "telemetry.h"
+#include "tempering.h"
+#include "pipeline.h"
+#include "autoselect.h"
+#include "batchhill.h"
+#include "daemon.h"
+#include "trace.h"
+#include "util.h"
+
+/**
+ * @brief Function used to run the enum algorithm.
+ *
+ * Prints each solution on its own line as the columns of the queens of
+ * rows 0..N-1, as the solution iterator yields them, followed by the amount
+ * of solutions and the time spent.
+ *
+ * @param  queenAmount      Amount of queens
+ * @param  maxtime          Max time to spend enumerating
+ * @param  limit            Solutions to enumerate before stopping (0 for all)
+ * @param  progressInterval Seconds between progress snapshots (0 for none)
+ * @param  progressSocket   Unix socket for progress snapshots (null for stderr)
+ * @return                  Returns EXIT_FAILURE if the iterator can't be started else EXIT_SUCCESS.
+ */
+static int enumerateMain(int queenAmount, int maxtime, long long limit, int progressInterval, char *progressSocket) {
+    SolutionIterator *it;
+    const Point *solution;
+    clock_t startTime, elapsedTime;
+    int col;
+
+    if (initIterator(&it, queenAmount, maxtime) == EXIT_FAILURE) {
+        printf("Not enough memory for solution iterator! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    if (progressInterval != 0 && startTelemetry(progressInterval, maxtime, progressSocket) == EXIT_FAILURE) {
+        freeIterator(it);
+        printf("Progress reporter can't be started or socket can't be connected! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    startTime = clock();
+    while ((limit == 0 || it->count < limit) && (solution = nextSolution(it)) != NULL) {
+        PUBLISH_PROGRESS(nodes, it->count);
+        for (col = 0; col < queenAmount; col++) {
+            printf(col == 0 ? "%d" : " %d", solution[col].y);
+        }
+        printf("\n");
+    }
+    elapsedTime = clock() - startTime;
+    stopTelemetry();
+
+    printf("\nSolutions enumerated: %lld%s\n", it->count,
+           it->timeExpired ? " (time expired, enumeration is partial)" : "");
+    printf("Time spent: %f secs\n", (float) elapsedTime/CLOCKS_PER_SEC);
+    freeIterator(it);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Function used to run the enum algorithm with solver threads.
+ *
+ * Solver threads push solutions into a lock-free ring buffer and a writer
+ * thread writes them to stdout in batches, in the given format.
+ * Afterwards the amount of solutions, the time spent, and the pipeline's
+ * statistics (ring buffer stalls, write calls) are printed, to stderr
+ * if the format is binary so they don't mix with the records.
+ *
+ * @param  queenAmount      Amount of queens
+ * @param  maxtime          Max time to spend enumerating
+ * @param  threads          Amount of solver threads
+ * @param  limit            Solutions to enumerate before stopping (0 for all)
+ * @param  queueSize        Slots in the ring buffer
+ * @param  format           Format of the solutions written
+ * @param  progressInterval Seconds between progress snapshots (0 for none)
+ * @param  progressSocket   Unix socket for progress snapshots (null for stderr)
+ * @return                  Returns EXIT_FAILURE if the pipeline can't be started else EXIT_SUCCESS.
+ */
+static int enumerateParallelMain(int queenAmount, int maxtime, int threads, long long limit, size_t queueSize,
+                                 OutputFormat format, int progressInterval, char *progressSocket) {
+    PipelineStats stats;
+    FILE *out = (format == FORMAT_BINARY) ? stderr : stdout;
+    int status;
+
+    if (progressInterval != 0 && startTelemetry(progressInterval, maxtime, progressSocket) == EXIT_FAILURE) {
+        printf("Progress reporter can't be started or socket can't be connected! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    fflush(stdout); // Writer thread writes to the file descriptor directly
+    status = enumerateParallel(queenAmount, maxtime, threads, limit, queueSize, format, fileno(stdout), &stats);
+    stopTelemetry();
+    if (status == EXIT_FAILURE) {
+        printf("Not enough memory or threads for the enumeration pipeline! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    fprintf(out, "\nSolutions enumerated: %lld%s\n", stats.solutions,
+            stats.timeExpired ? " (time expired, enumeration is partial)" : "");
+    fprintf(out, "Time spent: %f secs\n", stats.secondsSpent);
+    fprintf(out, "Queue-full stalls (queue of %zu): %lld\n", stats.queueSize, stats.stalls);
+    fprintf(out, "Write calls: %lld (%lld bytes)\n", stats.writeCalls, stats.bytesWritten);
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief Function used to run the batch algorithm.
+ *
+ * Solves boards boards with the batched hill climbing, then as many boards
+ * of the same seeds as maxtime permits with solveHill one at a time, and
+ * prints the boards per second of both paths. solveHill draws from rand(),
+ * not the lanes' generators, so its boards differ but are just as random.
+ *
+ * @param  queenAmount      Amount of queens
+ * @param  maxtime          Max time to spend on each path
+ * @param  seed             Seed of the first board
+ * @param  boards           Amount of boards to solve
+ * @param  progressInterval Seconds between progress snapshots (0 for none)
+ * @param  progressSocket   Unix socket for progress snapshots (null for stderr)
+ * @return                  Returns EXIT_FAILURE if the batch can't be started else EXIT_SUCCESS.
+ */
+static int batchMain(int queenAmount, int maxtime, int seed, long long boards,
+                     int progressInterval, char *progressSocket) {
+    BatchStats stats;
+    Point *solution;
+    clock_t startTime, elapsedTime = 0;
+    long long k, scalarSolved = 0;
+    int restartsCount, movesMade, status;
+
+    if (progressInterval != 0 && startTelemetry(progressInterval, maxtime, progressSocket) == EXIT_FAILURE) {
+        printf("Progress reporter can't be started or socket can't be connected! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    status = solveHillBatch(queenAmount, maxtime, seed, boards, NULL, &stats);
+    stopTelemetry();
+    if (status == EXIT_FAILURE) {
+        printf("Batch needs N in range 1..%d and enough memory! Exiting...\n", BATCH_MAX_N);
+        return EXIT_FAILURE;
+    }
+
+    printf("Batched (%d lanes): %lld/%lld boards solved%s\n", BATCH_LANES, stats.solved, boards,
+           stats.timeExpired ? " (time expired)" : "");
+    printf("Time spent: %f secs\n", stats.secondsSpent);
+    printf("Boards/sec: %.1f\n", stats.secondsSpent > 0 ? stats.solved / stats.secondsSpent : 0.0);
+    printf("Restarts: %lld, queens moved: %lld, lane utilization: %.1f%%\n", stats.restarts, stats.moves,
+           stats.sweeps ? 100.0 * stats.laneSweeps / (stats.sweeps * BATCH_LANES) : 0.0);
+
+    // Scalar path for comparison, one board at a time
+    startTime = clock();
+    for (k = 0; k < boards && (int) ((float) elapsedTime/CLOCKS_PER_SEC) < maxtime; k++) {
+        solution = solveHill(queenAmount, maxtime - (int) ((float) elapsedTime/CLOCKS_PER_SEC), seed + k, 0, NULL, NULL,
+                             &restartsCount, &movesMade);
+        if (solution != NULL) {
+            scalarSolved++;
+            free(solution);
+        }
+        elapsedTime = clock() - startTime;
+    }
+
+    printf("\nScalar (solveHill): %lld/%lld boards solved%s\n", scalarSolved, boards,
+           scalarSolved < boards ? " (time expired)" : "");
+    printf("Time spent: %f secs\n", (float) elapsedTime/CLOCKS_PER_SEC);
+    printf("Boards/sec: %.1f\n", elapsedTime > 0 ? scalarSolved / ((float) elapsedTime/CLOCKS_PER_SEC) : 0.0);
+
+    return EXIT_SUCCESS;
+}
 
 /**
  * @brief Main function used to run the program.
@@ -23,10 +196,37 @@
  * b) maxtime is paired with maxtime number,
  * c) seed (if it exists) is paired with seed number.
  * Pairs can be entered in any order and:
- * 1) Seed is optional but if the algorithm is DFS then no seed must be entered,
+ * 1) Seed is optional but if the algorithm is DFS, MRV, DLX, enum, calibrate, or daemon then no seed must be entered,
  * 2) Maxtime and algorithm type are not optional arguments,
  * 3) Negative numbers are not accepted,
- * 4) Argument count cannot be different than 5 or 7.
+ * 4) Arguments must come in pairs,
+ * 5) Preset (file of pre-placed queens) and mode (first or count) are optional
+ * and only taken by DLX,
+ * 6) Progress (seconds between progress snapshots) is optional, and
+ * progresssocket (Unix socket to send them to instead of stderr) needs it,
+ * 7) Threads (replicas, default 4) is optional and only taken by PT,
+ * 8) Limit (solutions to enumerate) is optional and only taken by enum,
+ * 9) Threads can also be given to enum, which then runs solver threads that
+ * feed a writer thread; format (lines, board, or binary) and queue (ring
+ * buffer slots, default 1024) are optional and only taken then,
+ * 10) Calibration (table file, default calibration.txt) is optional and only
+ * taken by auto, and by calibrate, which sweeps N up to the number given with
+ * maxtime seconds per run and writes the table instead of solving,
+ * 11) Boards (amount of boards, default 10000) is optional and only taken by
+ * batch, which solves them with seeds seed..seed+boards-1 and compares the
+ * batched and scalar hill climbing,
+ * 12) Space (rows, the default, or perm) is optional and only taken by hill
+ * and ann; perm searches permutations with swap moves from a greedy start,
+ * 13) Restart (localmin, the default, luby, geometric, or stall), cutoff
+ * (steps of the policy's unit, default N), factor (growth of geometric
+ * cutoffs, default 1.5) and partial (yes to re-randomize only threatened
+ * queens at local minima, default no) are optional and only taken by hill;
+ * restart stall needs partial yes,
+ * 14) Socket (path to listen on) is needed by daemon, whose number is its
+ * workers; maxn (largest N served, default 4096) and queue (requests
+ * waiting, default 64) are optional, and maxtime is the largest deadline,
+ * 15) Trace (file to record the search to) is optional and only taken by
+ * DFS, hill, ann, and PT, in a build with tracing ('make TRACE=1').
  *
  * @param  argc Argument count
  * @param  argv Arguments array in string form
@@ -34,14 +234,31 @@
  */
 int main(int argc, char *argv[]) {
     // Incorrect amount of arguments check
-    if (argc != 5 && argc != 7) {
+    if (argc < 5 || argc % 2 == 0) {
         printf("Wrong number of arguments! Exiting...\n");
         return EXIT_FAILURE;
     }
 
     int i, queenAmount = 0, maxtime = 0, seed = 0,
-        isDFS = 0, isHill = 0, isAnn = 0,
-        foundAlgorithm = 0, foundMaxtime = 0, foundSeed = 0;
+        isDFS = 0, isHill = 0, isAnn = 0, isMRV = 0, isDLX = 0, isPT = 0, isEnum = 0, isAuto = 0, isCalibrate = 0, isBatch = 0, isDaemon = 0, countAll = 0, threads = 0,
+        foundAlgorithm = 0, foundMaxtime = 0, foundSeed = 0, foundMode = 0;
+    char *presetPath = NULL; // File of pre-placed queens
+    long long limit = 0;     // Solutions to enumerate (0 for all)
+    long long boards = 0;    // Boards to solve (batch only)
+    char *socketPath = NULL; // Socket to listen on (daemon only)
+    char *tracePath = NULL;  // File to record a search trace to (dfs, hill, ann, pt only)
+    int maxN = 0;            // Largest N served (daemon only)
+    int foundSpace = 0, permutation = 0; // Permutation state space (hill and ann only)
+    int foundRestart = 0, foundPartial = 0, foundFactor = 0; // Restart policy given (hill only)
+    RestartPolicy policy = {RESTART_LOCAL_MIN, 0, 1.5, 0};
+    RunLengths runLengths;
+    double convD;       // To convert argv[x] to double
+    int foundFormat = 0;     // Output format given (enum with threads only)
+    OutputFormat format = FORMAT_LINES;
+    size_t queueSize = 0;    // Ring buffer slots (enum with threads only)
+    char *calibrationPath = NULL; // Calibration table (auto and calibrate only)
+    int progressInterval = 0;   // Seconds between progress snapshots (0 for none)
+    char *progressSocket = NULL; // Unix socket for progress snapshots (null for stderr)
     unsigned long conv; // To convert argv[x] to unsigned long
     char *convP;        // End value pointer for conversion
 
@@ -148,6 +365,431 @@ int main(int argc, char *argv[]) {
             }
         }
 
+        // Argument is mrv
+        else if (strcmp(argv[i], "mrv") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > INT_MAX) {
+                    printf("Number given for N is not positive integer or algorithm isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv;
+                    foundAlgorithm = 1;
+                    isMRV = 1;
+                }
+            }
+        }
+
+        // Argument is dlx
+        else if (strcmp(argv[i], "dlx") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > INT_MAX) {
+                    printf("Number given for N is not positive integer or algorithm isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv;
+                    foundAlgorithm = 1;
+                    isDLX = 1;
+                }
+            }
+        }
+
+        // Argument is pt
+        else if (strcmp(argv[i], "pt") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > INT_MAX) {
+                    printf("Number given for N is not positive integer or algorithm isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv;
+                    foundAlgorithm = 1;
+                    isPT = 1;
+                }
+            }
+        }
+
+        // Argument is enum
+        else if (strcmp(argv[i], "enum") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > INT_MAX) {
+                    printf("Number given for N is not positive integer or algorithm isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv;
+                    foundAlgorithm = 1;
+                    isEnum = 1;
+                }
+            }
+        }
+
+        // Argument is auto or calibrate
+        else if (strcmp(argv[i], "auto") == 0 || strcmp(argv[i], "calibrate") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > INT_MAX) {
+                    printf("Number given for N is not positive integer or algorithm isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv;
+                    foundAlgorithm = 1;
+                    isAuto = (argv[i][0] == 'a');
+                    isCalibrate = !isAuto;
+                }
+            }
+        }
+
+        // Argument is batch
+        else if (strcmp(argv[i], "batch") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > INT_MAX) {
+                    printf("Number given for N is not positive integer or algorithm isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv;
+                    foundAlgorithm = 1;
+                    isBatch = 1;
+                }
+            }
+        }
+
+        // Argument is daemon
+        else if (strcmp(argv[i], "daemon") == 0) {
+            if (foundAlgorithm) {
+                printf("Algorithm argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv > MAX_REPLICAS) {
+                    printf("Number given for workers is not in range 1..%d or daemon isn't paired! Exiting...\n", MAX_REPLICAS);
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queenAmount = conv; // Workers, checked as non-zero with the queens
+                    foundAlgorithm = 1;
+                    isDaemon = 1;
+                }
+            }
+        }
+
+        // Argument is trace
+        else if (strcmp(argv[i], "trace") == 0) {
+            if (tracePath != NULL) {
+                printf("Trace argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                tracePath = argv[i+1];
+            }
+        }
+
+        // Argument is socket
+        else if (strcmp(argv[i], "socket") == 0) {
+            if (socketPath != NULL) {
+                printf("Socket argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                socketPath = argv[i+1];
+            }
+        }
+
+        // Argument is maxn
+        else if (strcmp(argv[i], "maxn") == 0) {
+            if (maxN != 0) {
+                printf("Maxn argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > INT_MAX / 2) {
+                    printf("Number given for maxn is not positive integer or maxn isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    maxN = conv;
+                }
+            }
+        }
+
+        // Argument is boards
+        else if (strcmp(argv[i], "boards") == 0) {
+            if (boards != 0) {
+                printf("Boards argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > INT_MAX) {
+                    printf("Number given for boards is not positive integer or boards isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    boards = conv;
+                }
+            }
+        }
+
+        // Argument is calibration
+        else if (strcmp(argv[i], "calibration") == 0) {
+            if (calibrationPath != NULL) {
+                printf("Calibration argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                calibrationPath = argv[i+1];
+            }
+        }
+
+        // Argument is limit
+        else if (strcmp(argv[i], "limit") == 0) {
+            if (limit != 0) {
+                printf("Limit argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > INT_MAX) {
+                    printf("Number given for limit is not positive integer or limit isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    limit = conv;
+                }
+            }
+        }
+
+        // Argument is threads
+        else if (strcmp(argv[i], "threads") == 0) {
+            if (threads != 0) {
+                printf("Threads argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > MAX_REPLICAS) {
+                    printf("Number given for threads is not in range 1..%d or threads isn't paired! Exiting...\n", MAX_REPLICAS);
+                    return EXIT_FAILURE;
+                }
+                else {
+                    threads = conv;
+                }
+            }
+        }
+
+        // Argument is format
+        else if (strcmp(argv[i], "format") == 0) {
+            if (foundFormat) {
+                printf("Format argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else if (strcmp(argv[i+1], "lines") == 0 || strcmp(argv[i+1], "board") == 0
+                     || strcmp(argv[i+1], "binary") == 0) {
+                format = (argv[i+1][0] == 'l') ? FORMAT_LINES : (argv[i+1][0] == 'b' && argv[i+1][1] == 'o') ? FORMAT_BOARD : FORMAT_BINARY;
+                foundFormat = 1;
+            }
+            else {
+                printf("Format must be lines, board, or binary! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Argument is queue
+        else if (strcmp(argv[i], "queue") == 0) {
+            if (queueSize != 0) {
+                printf("Queue argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > INT_MAX) {
+                    printf("Number given for queue is not positive integer or queue isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    queueSize = conv;
+                }
+            }
+        }
+
+        // Argument is preset
+        else if (strcmp(argv[i], "preset") == 0) {
+            if (presetPath != NULL) {
+                printf("Preset argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                presetPath = argv[i+1];
+            }
+        }
+
+        // Argument is mode
+        else if (strcmp(argv[i], "mode") == 0) {
+            if (foundMode) {
+                printf("Mode argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else if (strcmp(argv[i+1], "first") == 0 || strcmp(argv[i+1], "count") == 0) {
+                countAll = (strcmp(argv[i+1], "count") == 0);
+                foundMode = 1;
+            }
+            else {
+                printf("Mode must be first or count! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Argument is space
+        else if (strcmp(argv[i], "space") == 0) {
+            if (foundSpace) {
+                printf("Space argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else if (strcmp(argv[i+1], "rows") == 0 || strcmp(argv[i+1], "perm") == 0) {
+                permutation = (strcmp(argv[i+1], "perm") == 0);
+                foundSpace = 1;
+            }
+            else {
+                printf("Space must be rows or perm! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Argument is restart
+        else if (strcmp(argv[i], "restart") == 0) {
+            if (foundRestart) {
+                printf("Restart argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else if (strcmp(argv[i+1], "localmin") == 0 || strcmp(argv[i+1], "luby") == 0
+                     || strcmp(argv[i+1], "geometric") == 0 || strcmp(argv[i+1], "stall") == 0) {
+                policy.kind = (argv[i+1][0] == 'l' && argv[i+1][1] == 'o') ? RESTART_LOCAL_MIN
+                              : (argv[i+1][0] == 'l') ? RESTART_LUBY
+                              : (argv[i+1][0] == 'g') ? RESTART_GEOMETRIC : RESTART_STALL;
+                foundRestart = 1;
+            }
+            else {
+                printf("Restart must be localmin, luby, geometric, or stall! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Argument is cutoff
+        else if (strcmp(argv[i], "cutoff") == 0) {
+            if (policy.unit != 0) {
+                printf("Cutoff argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > INT_MAX) {
+                    printf("Number given for cutoff is not positive integer or cutoff isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    policy.unit = conv;
+                }
+            }
+        }
+
+        // Argument is factor
+        else if (strcmp(argv[i], "factor") == 0) {
+            if (foundFactor) {
+                printf("Factor argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                convD = strtod(argv[i+1], &convP);
+                if (errno != 0 || *convP != '\0' || !(convD >= 1) || convD > 16) {
+                    printf("Number given for factor is not in range 1..16 or factor isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    policy.factor = convD;
+                    foundFactor = 1;
+                }
+            }
+        }
+
+        // Argument is partial
+        else if (strcmp(argv[i], "partial") == 0) {
+            if (foundPartial) {
+                printf("Partial argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else if (strcmp(argv[i+1], "yes") == 0 || strcmp(argv[i+1], "no") == 0) {
+                policy.partial = (strcmp(argv[i+1], "yes") == 0);
+                foundPartial = 1;
+            }
+            else {
+                printf("Partial must be yes or no! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+        }
+
+        // Argument is progress
+        else if (strcmp(argv[i], "progress") == 0) {
+            if (progressInterval != 0) {
+                printf("Progress argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                conv = strtoul(argv[i+1], &convP, 10);
+                if (errno != 0 || *convP != '\0' || conv == 0 || conv > INT_MAX) {
+                    printf("Number given for progress is not positive integer or progress isn't paired! Exiting...\n");
+                    return EXIT_FAILURE;
+                }
+                else {
+                    progressInterval = conv;
+                }
+            }
+        }
+
+        // Argument is progresssocket
+        else if (strcmp(argv[i], "progresssocket") == 0) {
+            if (progressSocket != NULL) {
+                printf("Progresssocket argument entered twice! Exiting...\n");
+                return EXIT_FAILURE;
+            }
+            else {
+                progressSocket = argv[i+1];
+            }
+        }
+
         // Invalid argument
         else {
             printf("Wrong argument or bad pair of arguments! Exiting...\n");
@@ -161,9 +803,56 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
-    // DFS with seed argument
-    if (isDFS && foundSeed) {
-        printf("DFS algorithm can't take seed argument! Exiting...\n");
+    // Exhaustive algorithm with seed argument
+    if ((isDFS || isMRV || isDLX || isEnum || isCalibrate || isDaemon) && foundSeed) {
+        printf("%s algorithm can't take seed argument! Exiting...\n",
+               isDFS ? "DFS" : isMRV ? "MRV" : isDLX ? "DLX" : isEnum ? "Enum" : isCalibrate ? "Calibrate" : "Daemon");
+        return EXIT_FAILURE;
+    }
+
+    // Preset or mode without DLX
+    if (!isDLX && (presetPath != NULL || foundMode)) {
+        printf("Only DLX algorithm can take preset and mode arguments! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    // Space without local search
+    if (!isHill && !isAnn && foundSpace) {
+        printf("Only hill and ann algorithms can take space argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    // Restart policy without hill climbing
+    if (!isHill && (foundRestart || policy.unit != 0 || foundFactor || foundPartial)) {
+        printf("Only hill algorithm can take restart, cutoff, factor, and partial arguments! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    if ((policy.kind == RESTART_LOCAL_MIN && policy.unit != 0)
+        || (policy.kind != RESTART_GEOMETRIC && foundFactor)) {
+        printf("Cutoff needs restart luby, geometric, or stall, and factor needs restart geometric! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    // Without partial restarts every local minimum restarts the run, so no stall is ever long enough
+    if (policy.kind == RESTART_STALL && !policy.partial) {
+        printf("Restart stall needs partial yes! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    // Trace without a traced algorithm, or in a build without tracing
+    if (tracePath != NULL && !isDFS && !isHill && !isAnn && !isPT) {
+        printf("Only dfs, hill, ann, and pt algorithms can take trace argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+#ifndef TRACE
+    if (tracePath != NULL) {
+        printf("Tracing is compiled out, rebuild with 'make clean && make TRACE=1'! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+#endif
+
+    // Daemon's number is its workers
+    if (isDaemon && queenAmount == 0) {
+        printf("Daemon needs at least 1 worker! Exiting...\n");
         return EXIT_FAILURE;
     }
 
@@ -173,15 +862,141 @@ int main(int argc, char *argv[]) {
         return EXIT_FAILURE;
     }
 
+    // Calibration table without auto or calibrate
+    if (!isAuto && !isCalibrate && calibrationPath != NULL) {
+        printf("Only auto and calibrate algorithms can take calibration argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    if (calibrationPath == NULL) {
+        calibrationPath = "calibration.txt";
+    }
+
+    // Limit without enumeration
+    if (!isEnum && limit != 0) {
+        printf("Only enum algorithm can take limit argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    // Boards without batch
+    if (!isBatch && boards != 0) {
+        printf("Only batch algorithm can take boards argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    if (boards == 0) {
+        boards = 10000;
+    }
+
+    // Threads without parallel tempering or enumeration
+    if (!isPT && !isEnum && threads != 0) {
+        printf("Only PT and enum algorithms can take threads argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    // Format or queue without threaded enumeration (daemon takes queue too)
+    if ((!isEnum || threads == 0) && (foundFormat || (queueSize != 0 && !isDaemon))) {
+        printf("Only enum algorithm with threads can take format and queue arguments! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    if (queueSize == 0) {
+        queueSize = isDaemon ? 64 : 1024;
+    }
+
+    // Socket and maxn without daemon, or daemon without socket
+    if (isDaemon != (socketPath != NULL) || (!isDaemon && maxN != 0)) {
+        printf("Daemon needs socket argument, and only daemon can take socket and maxn arguments! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    // Deadlines are 32-bit milliseconds on the wire
+    if (isDaemon && (maxtime == 0 || (unsigned long) maxtime > UINT32_MAX / 1000)) {
+        printf("Daemon needs maxtime in range 1..%lu seconds! Exiting...\n", (unsigned long) (UINT32_MAX / 1000));
+        return EXIT_FAILURE;
+    }
+    if (maxN == 0) {
+        maxN = 4096;
+    }
+    if (isPT && threads == 0) {
+        threads = 4;
+    }
+
+    // Progress socket without progress interval
+    if (progressSocket != NULL && progressInterval == 0) {
+        printf("Progresssocket argument needs progress argument! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    if (policy.unit == 0) {
+        policy.unit = queenAmount; // Default cutoff grows with the board
+    }
+
     // Non-DFS algorithm and seed not given
     // Set current time as seed instead
-    if (!isDFS && !foundSeed) {
+    if (!isDFS && !isMRV && !isDLX && !isEnum && !isCalibrate && !foundSeed) {
         seed = clock();
     }
 
+    // Calibration writes a table instead of solving
+    if (isCalibrate) {
+        CalibrationTable table;
+        if (queenAmount < 4) {
+            printf("Calibration needs N of at least 4! Exiting...\n");
+            return EXIT_FAILURE;
+        }
+        calibrate(queenAmount, maxtime, 3, &table, stdout);
+        if (writeCalibration(calibrationPath, &table) == EXIT_FAILURE) {
+            printf("Calibration file %s can't be written! Exiting...\n", calibrationPath);
+            return EXIT_FAILURE;
+        }
+        printf("\nCalibration table written to %s\n", calibrationPath);
+        return EXIT_SUCCESS;
+    }
+
+    // Daemon serves requests until stopped by a signal
+    if (isDaemon) {
+        if (progressInterval != 0) {
+            printf("Daemon can't take progress argument! Exiting...\n");
+            return EXIT_FAILURE;
+        }
+        if (runDaemon(socketPath, queenAmount, maxN, maxtime, queueSize, stdout) == EXIT_FAILURE) {
+            printf("Daemon can't listen on %s or start its workers! Exiting...\n", socketPath);
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Batch solves many boards instead of printing one
+    if (isBatch) {
+        return batchMain(queenAmount, maxtime, seed, boards, progressInterval, progressSocket);
+    }
+
+    // Enumeration streams every solution instead of printing one board
+    if (isEnum && threads != 0) {
+        return enumerateParallelMain(queenAmount, maxtime, threads, limit, queueSize, format,
+                                     progressInterval, progressSocket);
+    }
+    if (isEnum) {
+        return enumerateMain(queenAmount, maxtime, limit, progressInterval, progressSocket);
+    }
+
     Point *solution = NULL;
+    DLX *dlx = NULL;
+    TemperingStats ptStats;
+    CalibrationTable table;
+    EngineChoice autoEngine;
+    int autoFallback = 0;
+    char engine[16];
     clock_t startTime = 0, elapsedTime = 0;
-    int restartsCount, movesMade;
+    int restartsCount, movesMade, backtracks;
+
+    if (progressInterval != 0 && startTelemetry(progressInterval, maxtime, progressSocket) == EXIT_FAILURE) {
+        printf("Progress reporter can't be started or socket can't be connected! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    if (tracePath != NULL && startTrace(tracePath) == EXIT_FAILURE) {
+        stopTelemetry();
+        printf("Trace file %s can't be written! Exiting...\n", tracePath);
+        return EXIT_FAILURE;
+    }
+
     if (isDFS) {
         startTime = clock();
         solution = solveDFS(queenAmount, maxtime);
@@ -189,17 +1004,67 @@ int main(int argc, char *argv[]) {
     }
     else if (isHill) {
         startTime = clock();
-        solution = solveHill(queenAmount, maxtime, seed, &restartsCount, &movesMade);
+        solution = solveHill(queenAmount, maxtime, seed, permutation, &policy, &runLengths, &restartsCount, &movesMade);
         elapsedTime = clock() - startTime;
     }
     else if (isAnn) {
         startTime = clock();
-        solution = solveAnn(queenAmount, maxtime, seed, &movesMade);
+        solution = solveAnn(queenAmount, maxtime, seed, permutation, &movesMade);
+        elapsedTime = clock() - startTime;
+    }
+    else if (isMRV) {
+        startTime = clock();
+        solution = solveMRV(queenAmount, maxtime, &backtracks, &restartsCount);
+        elapsedTime = clock() - startTime;
+        if (restartsCount < 0) {
+            stopTelemetry();
+            printf("Not enough memory for MRV engine! Exiting...\n");
+            return EXIT_FAILURE;
+        }
+    }
+    else if (isAuto) {
+        if (loadCalibration(calibrationPath, &table) == EXIT_FAILURE) {
+            printf("Calibration file %s can't be read or is invalid, using default table.\n", calibrationPath);
+            defaultCalibration(&table);
+        }
+        // Engines may run threads, report wall time
+        struct timespec wallStart;
+        clock_gettime(CLOCK_MONOTONIC, &wallStart);
+        solution = solveAuto(queenAmount, maxtime, seed, &table, &autoEngine, &autoFallback);
+        elapsedTime = secondsSince(&wallStart) * CLOCKS_PER_SEC;
+    }
+    else if (isPT) {
+        solution = solveTempering(queenAmount, maxtime, seed, threads, &ptStats);
+        // Threads run in parallel, report wall time instead of CPU time
+        elapsedTime = ptStats.secondsSpent * CLOCKS_PER_SEC;
+    }
+    else if (isDLX) {
+        if (initDLX(&dlx, queenAmount) == EXIT_FAILURE) {
+            stopTelemetry();
+            printf("Not enough memory for DLX engine! Exiting...\n");
+            return EXIT_FAILURE;
+        }
+        if (presetPath != NULL && loadPresetDLX(dlx, presetPath) == EXIT_FAILURE) {
+            stopTelemetry();
+            printf("Preset file can't be read or has invalid or threatened queens! Exiting...\n");
+            freeDLX(dlx);
+            return EXIT_FAILURE;
+        }
+        startTime = clock();
+        solution = solveDLX(dlx, maxtime, countAll);
         elapsedTime = clock() - startTime;
     }
 
+    stopTelemetry();
+    if (tracePath != NULL && stopTrace() == EXIT_FAILURE) {
+        printf("Trace file %s couldn't be fully written.\n", tracePath);
+    }
+
     if (solution == NULL) {
         printf("NO SOLUTION FOUND\n");
+        if ((isDLX && countAll) || isPT || isAuto) {
+            printf("\nTime spent: %f secs\n", (float) elapsedTime/CLOCKS_PER_SEC);
+        }
     }
     else {
         printf("SOLUTION FOUND\n\n");
@@ -218,12 +1083,49 @@ int main(int argc, char *argv[]) {
         free(solution);
 
         printf("\nTime spent: %f secs\n", (float) elapsedTime/CLOCKS_PER_SEC);
-        if (isHill) {
+        if (isHill || isMRV) {
             printf("Restarts made to solve the problem: %d\n", restartsCount);
         }
         if (isHill || isAnn) {
             printf("Queens placed or moved to solve the problem: %d\n", movesMade);
         }
+        if (isMRV) {
+            printf("Backtracks made to solve the problem: %d\n", backtracks);
+        }
+    }
+
+    if (isHill) {
+        printf("Run lengths (steps, %lld runs finished, %.1f steps on average):\n", runLengths.runs,
+               runLengths.runs ? (double) runLengths.steps / runLengths.runs : 0.0);
+        for (i = 0; i < RUN_BUCKETS; i++) {
+            if (runLengths.buckets[i] != 0) {
+                printf("  [%lld, %lld): %lld\n", i == 0 ? 0LL : 1LL << i, 2LL << i, runLengths.buckets[i]);
+            }
+        }
+    }
+
+    if (isAuto) {
+        printf("Engine used: %s%s\n", engineName(autoEngine, engine), autoFallback ? " (fallback)" : "");
+    }
+
+    if (isPT) {
+        printf("Queens moved by all replicas: %lld\n", ptStats.movesMade);
+        printf("Exchange acceptance rates:\n");
+        for (i = 0; i + 1 < ptStats.replicas; i++) {
+            printf("  T=%.3f <-> T=%.3f: %lld/%lld (%.1f%%)\n",
+                   ptStats.temperatures[i], ptStats.temperatures[i + 1],
+                   ptStats.swapAccepts[i], ptStats.swapAttempts[i],
+                   ptStats.swapAttempts[i] ? 100.0 * ptStats.swapAccepts[i] / ptStats.swapAttempts[i] : 0.0);
+        }
+    }
+
+    if (isDLX) {
+        if (countAll) {
+            printf("Solutions counted: %lld%s\n", dlx->solutions,
+                   dlx->timeExpired ? " (time expired, count is partial)" : "");
+        }
+        printf("Node updates made to solve the problem: %lld\n", dlx->updates);
+        freeDLX(dlx);
     }
 
     return EXIT_SUCCESS;
@@ -0,0 +1,249 @@
+/**
+ * @file pipeline.c
+ * @brief Implements functions of pipeline.h file.
+ */
+
+#include "pipeline.h"
+#include "telemetry.h"
+#include "util.h"
+#include <pthread.h>	// for threads
+#include <unistd.h>	// for write
+#include <sched.h>	// for sched_yield
+
+#define WRITE_BATCH (1 << 16) // Minimum bytes buffered before a write
+#define IDLE_FLUSH_POLLS 100  // Empty polls (of 100us) before flushing a partial batch
+
+/**
+ * @brief Data shared by the solver threads and the writer thread.
+ */
+typedef struct {
+    int N, threads;
+    long long limit;
+    OutputFormat format;
+    int fd;
+    RingBuffer *ring;
+    int nextFirstCol;       // Next column of row 0 to enumerate
+    long long produced;     // Solutions claimed by solver threads (for limit)
+    int cancel;             // Set to stop the solver threads
+    int solversDone;        // Solver threads that finished
+    int failed;             // Set if a solver thread couldn't allocate its buffers
+    char *batch;            // Writer's buffer of formatted records
+    int *record;            // Writer's record popped from the ring
+    PipelineStats *stats;
+} Pipeline;
+
+/**
+ * @brief Solver thread loop, pushes the solutions of every first column it takes.
+ */
+static void *runSolver(void *arg) {
+    Pipeline *p = arg;
+    SolutionIterator *it;
+    const Point *solution;
+    int *record = malloc(p->N * sizeof(int));
+    int col, i;
+
+    if (record == NULL || initIterator(&it, p->N, INT_MAX) == EXIT_FAILURE) {
+        free(record);
+        __atomic_store_n(&p->failed, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&p->cancel, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&p->solversDone, 1, __ATOMIC_RELEASE);
+        return NULL;
+    }
+    it->cancel = &p->cancel;
+
+    while (!__atomic_load_n(&p->cancel, __ATOMIC_RELAXED)
+           && (col = __atomic_fetch_add(&p->nextFirstCol, 1, __ATOMIC_RELAXED)) < p->N) {
+        restrictIterator(it, col);
+        while ((solution = nextSolution(it)) != NULL) {
+            if (p->limit != 0 && __atomic_fetch_add(&p->produced, 1, __ATOMIC_RELAXED) >= p->limit) {
+                __atomic_store_n(&p->cancel, 1, __ATOMIC_RELAXED);
+                break;
+            }
+            for (i = 0; i < p->N; i++) {
+                record[i] = solution[i].y;
+            }
+            pushRing(p->ring, record);
+        }
+    }
+
+    freeIterator(it);
+    free(record);
+    __atomic_fetch_add(&p->solversDone, 1, __ATOMIC_RELEASE);
+
+    return NULL;
+}
+
+/**
+ * @brief Helper function to write all of a buffer, retrying partial writes.
+ */
+static void writeAll(Pipeline *p, const char *buffer, size_t length) {
+    ssize_t written;
+
+    while (length > 0) {
+        written = write(p->fd, buffer, length);
+        if (written <= 0) {
+            return; // Output closed, drop the rest
+        }
+        p->stats->writeCalls++;
+        p->stats->bytesWritten += written;
+        buffer += written;
+        length -= written;
+    }
+}
+
+/**
+ * @brief Helper function to format a record at the end of the batch buffer.
+ * @return Returns the bytes appended.
+ */
+static size_t formatRecord(Pipeline *p, const int *record, char *out) {
+    char *start = out;
+    int row, col;
+
+    switch (p->format) {
+        case FORMAT_BINARY:
+            memcpy(out, record, p->N * sizeof(int));
+            return p->N * sizeof(int);
+        case FORMAT_BOARD:
+            for (row = 0; row < p->N; row++) {
+                for (col = 0; col < p->N; col++) {
+                    *out++ = (record[row] == col) ? 'Q' : '+';
+                    *out++ = ' ';
+                }
+                *out++ = '\n';
+            }
+            *out++ = '\n';
+            return out - start;
+        default:
+            for (row = 0; row < p->N; row++) {
+                out += sprintf(out, row == 0 ? "%d" : " %d", record[row]);
+            }
+            *out++ = '\n';
+            return out - start;
+    }
+}
+
+/**
+ * @brief Writer thread loop, pops and batches records until the solvers finish.
+ */
+static void *runWriter(void *arg) {
+    Pipeline *p = arg;
+    char *batch = p->batch;
+    int *record = p->record;
+    size_t used = 0;
+    int idlePolls = 0;
+    struct timespec nap = {0, 100000};
+
+    for (;;) {
+        if (tryPopRing(p->ring, record) == EXIT_SUCCESS) {
+            used += formatRecord(p, record, batch + used);
+            p->stats->solutions++;
+            PUBLISH_PROGRESS(nodes, p->stats->solutions);
+            if (used >= WRITE_BATCH) {
+                writeAll(p, batch, used);
+                used = 0;
+            }
+            idlePolls = 0;
+            continue;
+        }
+
+        // Empty: finished if all solvers are done and nothing was pushed meanwhile
+        if (__atomic_load_n(&p->solversDone, __ATOMIC_ACQUIRE) == p->threads) {
+            if (tryPopRing(p->ring, record) == EXIT_SUCCESS) {
+                used += formatRecord(p, record, batch + used);
+                p->stats->solutions++;
+                continue;
+            }
+            break;
+        }
+
+        // Solvers are slow, don't hold a partial batch back for long
+        if (++idlePolls == IDLE_FLUSH_POLLS && used > 0) {
+            writeAll(p, batch, used);
+            used = 0;
+        }
+        nanosleep(&nap, NULL);
+    }
+
+    if (used > 0) {
+        writeAll(p, batch, used);
+    }
+
+    return NULL;
+}
+
+int enumerateParallel(int N, int maxtime, int threads, long long limit, size_t queueSize,
+                      OutputFormat format, int fd, PipelineStats *stats) {
+    if (N <= 0 || threads <= 0 || stats == NULL) {
+        return EXIT_FAILURE;
+    }
+
+    Pipeline p;
+    pthread_t writer, *solvers = malloc(threads * sizeof(pthread_t));
+    size_t recordMax = (size_t) N * (2 * N + 12) + 2; // Longest formatted record
+    char *batch = malloc(WRITE_BATCH + recordMax);
+    int *record = malloc(N * sizeof(int));
+    struct timespec start, nap = {0, 10000000};
+    int i, started;
+
+    memset(stats, 0, sizeof(PipelineStats));
+    memset(&p, 0, sizeof(Pipeline));
+    p.N = N;
+    p.threads = threads;
+    p.limit = limit;
+    p.format = format;
+    p.fd = fd;
+    p.batch = batch;
+    p.record = record;
+    p.stats = stats;
+    if (solvers == NULL || batch == NULL || record == NULL
+        || initRing(&p.ring, queueSize, N * sizeof(int)) == EXIT_FAILURE) {
+        free(solvers);
+        free(batch);
+        free(record);
+        return EXIT_FAILURE;
+    }
+    stats->queueSize = p.ring->capacity;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    if (pthread_create(&writer, NULL, runWriter, &p) != 0) {
+        freeRing(p.ring);
+        free(solvers);
+        free(batch);
+        free(record);
+        return EXIT_FAILURE;
+    }
+    for (started = 0; started < threads; started++) {
+        if (pthread_create(&solvers[started], NULL, runSolver, &p) != 0) {
+            break;
+        }
+    }
+    // Threads that couldn't start count as done so the writer can finish
+    if (started < threads) {
+        p.failed = 1;
+        __atomic_store_n(&p.cancel, 1, __ATOMIC_RELAXED);
+        __atomic_fetch_add(&p.solversDone, threads - started, __ATOMIC_RELEASE);
+    }
+
+    // Wait for the solvers, cancelling them when time expires
+    while (__atomic_load_n(&p.solversDone, __ATOMIC_ACQUIRE) < threads) {
+        nanosleep(&nap, NULL);
+        if (!__atomic_load_n(&p.cancel, __ATOMIC_RELAXED) && secondsSince(&start) >= maxtime) {
+            stats->timeExpired = 1;
+            __atomic_store_n(&p.cancel, 1, __ATOMIC_RELAXED);
+        }
+    }
+    for (i = 0; i < started; i++) {
+        pthread_join(solvers[i], NULL);
+    }
+    pthread_join(writer, NULL);
+
+    stats->secondsSpent = secondsSince(&start);
+    stats->stalls = p.ring->stalls;
+
+    freeRing(p.ring);
+    free(solvers);
+    free(batch);
+    free(record);
+
+    return p.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
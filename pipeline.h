@@ -0,0 +1,59 @@
+/**
+ *@file pipeline.h
+ *@brief Producer/consumer pipeline between solver threads and an output writer.
+ *
+ * This file includes the function prototype of a parallel enumeration where
+ * solver threads push the solutions they find into a lock-free ring buffer
+ * and a dedicated writer thread pops them, formats them, and writes them out
+ * in large batches, so solver threads never serialize on stdio locks.
+ * It uses the ring buffer from ringbuf.h and the solution iterator from enumerate.h.
+ */
+
+#ifndef PIPELINE_H
+#define PIPELINE_H
+#include "ringbuf.h"
+#include "enumerate.h"
+
+typedef enum {
+	FORMAT_LINES,   // Columns of the queens of rows 0..N-1 on one line
+	FORMAT_BOARD,   // Board of Q and + followed by an empty line
+	FORMAT_BINARY   // Columns as N native 32-bit integers
+} OutputFormat;
+
+typedef struct {
+	long long solutions;    // Solutions written
+	long long stalls;       // Pushes that found the ring buffer full
+	long long writeCalls;   // Calls to write made by the writer
+	long long bytesWritten; // Bytes written by the writer
+	size_t queueSize;       // Slots in the ring buffer
+	int timeExpired;        // 1 if the enumeration was stopped by maxtime
+	double secondsSpent;    // Wall time spent
+} PipelineStats;
+
+/**
+ * @brief Function to enumerate all solutions with solver threads and a writer thread.
+ *
+ * This function splits the enumeration by the column of the queen of row 0:
+ * every solver thread takes the next column not taken yet, restricts its own
+ * solution iterator to it, and pushes each solution into a ring buffer
+ * shared by all solver threads. A writer thread pops solutions, formats them
+ * in a buffer, and writes the buffer to fd when it's full, when the solvers
+ * are idle, or at the end. Solutions of different first columns are
+ * interleaved in the output.
+ * As the threads run in parallel, maxtime is measured in wall time.
+ * If a thread or buffer can't be created EXIT_FAILURE is returned.
+ *
+ * @param  N         Amount of queens.
+ * @param  maxtime   Max time to spend enumerating.
+ * @param  threads   Amount of solver threads.
+ * @param  limit     Solutions to enumerate before stopping (0 for all).
+ * @param  queueSize Minimum amount of slots in the ring buffer.
+ * @param  format    Format of the solutions written.
+ * @param  fd        File descriptor to write to.
+ * @param  stats     Statistics to be filled in and returned.
+ * @return           EXIT_FAILURE or EXIT_SUCCESS
+ */
+int enumerateParallel(int N, int maxtime, int threads, long long limit, size_t queueSize,
+                      OutputFormat format, int fd, PipelineStats *stats);
+
+#endif
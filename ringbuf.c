@@ -0,0 +1,102 @@
+/**
+ * @file ringbuf.c
+ * @brief Implements functions of ringbuf.h file.
+ */
+
+#include "ringbuf.h"
+#include <sched.h>	// for sched_yield
+
+int initRing(RingBuffer **rb, size_t capacity, size_t recordSize) {
+	if (rb == NULL || capacity == 0 || recordSize == 0)
+		return EXIT_FAILURE;
+
+	*rb = (RingBuffer *) malloc(sizeof(RingBuffer));
+	if (*rb == NULL)
+		return EXIT_FAILURE;
+
+	RingBuffer *r = *rb;
+	size_t i;
+
+	// Round up to a power of 2 so positions map to slots with a mask
+	for (r->capacity = 1; r->capacity < capacity; r->capacity *= 2)
+		;
+	r->recordSize = recordSize;
+	r->sequence = (size_t *) malloc(r->capacity * sizeof(size_t));
+	r->records = (unsigned char *) malloc(r->capacity * recordSize);
+	if (r->sequence == NULL || r->records == NULL) {
+		freeRing(r);
+		*rb = NULL;
+		return EXIT_FAILURE;
+	}
+
+	// Slot i is free for the producer of position i
+	for (i = 0; i < r->capacity; i++)
+		r->sequence[i] = i;
+	r->enqueuePos = 0;
+	r->dequeuePos = 0;
+	r->stalls = 0;
+
+	return EXIT_SUCCESS;
+}
+
+int tryPushRing(RingBuffer *rb, const void *record) {
+	size_t pos = __atomic_load_n(&rb->enqueuePos, __ATOMIC_RELAXED), seq, slot;
+
+	for (;;) {
+		slot = pos & (rb->capacity - 1);
+		seq = __atomic_load_n(&rb->sequence[slot], __ATOMIC_ACQUIRE);
+		if (seq == pos) {
+			// Slot is free, claim the position (pos is reloaded on failure)
+			if (__atomic_compare_exchange_n(&rb->enqueuePos, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+				break;
+		}
+		else if ((long) (seq - pos) < 0) {
+			// Slot still holds the record of the previous lap, buffer is full
+			return EXIT_FAILURE;
+		}
+		else {
+			// Another producer claimed the position first
+			pos = __atomic_load_n(&rb->enqueuePos, __ATOMIC_RELAXED);
+		}
+	}
+
+	memcpy(rb->records + slot * rb->recordSize, record, rb->recordSize);
+	// Publish the record to the consumer
+	__atomic_store_n(&rb->sequence[slot], pos + 1, __ATOMIC_RELEASE);
+
+	return EXIT_SUCCESS;
+}
+
+void pushRing(RingBuffer *rb, const void *record) {
+	if (tryPushRing(rb, record) == EXIT_SUCCESS)
+		return;
+
+	// Count the stall once, then wait for the consumer to free a slot
+	__atomic_fetch_add(&rb->stalls, 1, __ATOMIC_RELAXED);
+	do {
+		sched_yield();
+	} while (tryPushRing(rb, record) == EXIT_FAILURE);
+}
+
+int tryPopRing(RingBuffer *rb, void *record) {
+	size_t pos = rb->dequeuePos, slot = pos & (rb->capacity - 1);
+
+	if (__atomic_load_n(&rb->sequence[slot], __ATOMIC_ACQUIRE) != pos + 1)
+		return EXIT_FAILURE; // Empty, or producer hasn't finished copying
+
+	memcpy(record, rb->records + slot * rb->recordSize, rb->recordSize);
+	// Free the slot for the producer of the next lap
+	__atomic_store_n(&rb->sequence[slot], pos + rb->capacity, __ATOMIC_RELEASE);
+	rb->dequeuePos = pos + 1;
+
+	return EXIT_SUCCESS;
+}
+
+void freeRing(RingBuffer *rb) {
+	if (rb == NULL)
+		return;
+
+	free(rb->sequence);
+	free(rb->records);
+	free(rb);
+}
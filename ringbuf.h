@@ -0,0 +1,90 @@
+/**
+ *@file ringbuf.h
+ *@brief Bounded lock-free ring buffer of fixed-size records.
+ *
+ * This file includes function prototypes for a ring buffer that many
+ * producer threads can push records to and a single consumer thread can
+ * pop records from, without locks. Every slot has a sequence number that
+ * tells producers and the consumer whose turn it is to use the slot, so a
+ * producer only contends with other producers on the position counter.
+ * Pushes that find the buffer full are counted as stalls.
+ */
+
+#ifndef RINGBUF_H
+#define RINGBUF_H
+#include "def.h"
+
+#define CACHE_LINE 64
+
+typedef struct {
+	size_t capacity;          // Amount of slots (power of 2)
+	size_t recordSize;        // Bytes in a record
+	size_t *sequence;         // Sequence number of each slot
+	unsigned char *records;   // Records of all slots
+	char padProducer[CACHE_LINE];
+	size_t enqueuePos;        // Next position to push to (shared by producers)
+	long long stalls;         // Pushes that had to wait for a free slot
+	char padConsumer[CACHE_LINE];
+	size_t dequeuePos;        // Next position to pop from (consumer only)
+	char padEnd[CACHE_LINE];
+} RingBuffer;
+
+/**
+ * @brief Function to initialize a ring buffer.
+ *
+ * This function takes in a pointer to a ring buffer pointer and allocates
+ * the buffer with capacity rounded up to a power of 2 slots of recordSize bytes.
+ * If malloc fails or capacity or recordSize are 0 EXIT_FAILURE is returned.
+ *
+ * @param  rb         Pointer to ring buffer pointer
+ * @param  capacity   Minimum amount of slots
+ * @param  recordSize Bytes in a record
+ * @return            EXIT_FAILURE or EXIT_SUCCESS
+ */
+int initRing(RingBuffer **rb, size_t capacity, size_t recordSize);
+
+/**
+ * @brief Function to try pushing a record in a ring buffer.
+ *
+ * This function copies recordSize bytes of record in the next free slot.
+ * It can be called by many threads at once.
+ * If the buffer is full EXIT_FAILURE is returned and nothing is pushed.
+ *
+ * @param  rb     Ring buffer
+ * @param  record Record to copy
+ * @return        EXIT_FAILURE or EXIT_SUCCESS
+ */
+int tryPushRing(RingBuffer *rb, const void *record);
+
+/**
+ * @brief Function to push a record in a ring buffer, waiting while it's full.
+ *
+ * This function retries tryPushRing, yielding the processor between tries.
+ * A push that finds the buffer full is counted as one stall.
+ *
+ * @param  rb     Ring buffer
+ * @param  record Record to copy
+ */
+void pushRing(RingBuffer *rb, const void *record);
+
+/**
+ * @brief Function to try popping a record from a ring buffer.
+ *
+ * This function copies the oldest record in the buffer to record.
+ * It must only be called by a single consumer thread.
+ * If the buffer is empty EXIT_FAILURE is returned.
+ *
+ * @param  rb     Ring buffer
+ * @param  record Where to copy the record
+ * @return        EXIT_FAILURE or EXIT_SUCCESS
+ */
+int tryPopRing(RingBuffer *rb, void *record);
+
+/**
+ * @brief Function to free a ring buffer.
+ *
+ * @param  rb Ring buffer (can be null)
+ */
+void freeRing(RingBuffer *rb);
+
+#endif
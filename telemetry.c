@@ -0,0 +1,143 @@
+/**
+ * @file telemetry.c
+ * @brief Implements functions of telemetry.h file.
+ */
+
+#include "telemetry.h"
+#include "util.h"
+#include <pthread.h>	// for the reporter thread
+#include <unistd.h>	// for write, close
+#include <sys/socket.h>	// for socket, connect
+#include <sys/un.h>	// for sockaddr_un
+
+Telemetry telemetry = {0, 0, -1, 0, 0};
+
+static pthread_t reporter;
+static int reporterRunning = 0;
+static int stopRequested = 0;
+static int outFd = -1;
+static int reportInterval, reportMaxtime;
+static struct timespec reportStart;
+
+/**
+ * @brief Helper function to get the seconds passed since the reporter started.
+ */
+static double elapsedSeconds(void) {
+	return secondsSince(&reportStart);
+}
+
+/**
+ * @brief Helper function to write a snapshot of the shared counters.
+ *
+ * Rates are computed from the counters of the previous snapshot,
+ * which are updated in place.
+ */
+static void writeSnapshot(long long *prevNodes, long long *prevMoves, double *prevTime) {
+	char line[256];
+	int length;
+	double now = elapsedSeconds(), span = now - *prevTime;
+	long long nodes = __atomic_load_n(&telemetry.nodes, __ATOMIC_RELAXED),
+		moves = __atomic_load_n(&telemetry.moves, __ATOMIC_RELAXED),
+		best = __atomic_load_n(&telemetry.bestThreats, __ATOMIC_RELAXED),
+		restarts = __atomic_load_n(&telemetry.restarts, __ATOMIC_RELAXED),
+		depth = __atomic_load_n(&telemetry.depth, __ATOMIC_RELAXED);
+
+	if (span <= 0)
+		span = 1e-9;
+
+	length = snprintf(line, sizeof(line),
+		"[progress] elapsed %.1f/%d s | nodes %lld (%.0f/s) | moves %lld (%.0f/s)"
+		" | best threats %lld | restarts %lld | depth %lld\n",
+		now, reportMaxtime, nodes, (nodes - *prevNodes) / span,
+		moves, (moves - *prevMoves) / span, best, restarts, depth);
+	if (length >= (int) sizeof(line))
+		length = sizeof(line) - 1;
+	// A failed write (reader went away) only loses this report
+	if (outFd == STDERR_FILENO)
+		length = write(outFd, line, length);
+	else
+		length = send(outFd, line, length, MSG_NOSIGNAL);
+
+	*prevNodes = nodes;
+	*prevMoves = moves;
+	*prevTime = now;
+}
+
+/**
+ * @brief Reporter thread loop, prints a snapshot every interval seconds until stopped.
+ */
+static void *reportProgress(void *arg) {
+	long long prevNodes = 0, prevMoves = 0;
+	double prevTime = 0, nextReport = reportInterval;
+	struct timespec nap = {0, 50000000}; // Check for stop every 50ms
+	(void) arg;
+
+	while (!__atomic_load_n(&stopRequested, __ATOMIC_ACQUIRE)) {
+		nanosleep(&nap, NULL);
+		if (elapsedSeconds() >= nextReport) {
+			writeSnapshot(&prevNodes, &prevMoves, &prevTime);
+			nextReport += reportInterval;
+		}
+	}
+	writeSnapshot(&prevNodes, &prevMoves, &prevTime);
+
+	return NULL;
+}
+
+int startTelemetry(int interval, int maxtime, const char *socketPath) {
+	if (reporterRunning || interval <= 0)
+		return EXIT_FAILURE;
+
+	if (socketPath != NULL) {
+		struct sockaddr_un addr;
+		if (strlen(socketPath) >= sizeof(addr.sun_path))
+			return EXIT_FAILURE;
+		memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strcpy(addr.sun_path, socketPath);
+
+		outFd = socket(AF_UNIX, SOCK_STREAM, 0);
+		if (outFd < 0)
+			return EXIT_FAILURE;
+		if (connect(outFd, (struct sockaddr *) &addr, sizeof(addr)) != 0) {
+			close(outFd);
+			return EXIT_FAILURE;
+		}
+	}
+	else {
+		outFd = STDERR_FILENO;
+	}
+
+	telemetry.nodes = 0;
+	telemetry.moves = 0;
+	telemetry.bestThreats = -1;
+	telemetry.restarts = 0;
+	telemetry.depth = 0;
+
+	reportInterval = interval;
+	reportMaxtime = maxtime;
+	stopRequested = 0;
+	clock_gettime(CLOCK_MONOTONIC, &reportStart);
+
+	if (pthread_create(&reporter, NULL, reportProgress, NULL) != 0) {
+		if (outFd != STDERR_FILENO)
+			close(outFd);
+		return EXIT_FAILURE;
+	}
+	reporterRunning = 1;
+
+	return EXIT_SUCCESS;
+}
+
+void stopTelemetry(void) {
+	if (!reporterRunning)
+		return;
+
+	__atomic_store_n(&stopRequested, 1, __ATOMIC_RELEASE);
+	pthread_join(reporter, NULL);
+	reporterRunning = 0;
+
+	if (outFd != STDERR_FILENO)
+		close(outFd);
+	outFd = -1;
+}
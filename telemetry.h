@@ -0,0 +1,64 @@
+/**
+ *@file telemetry.h
+ *@brief Live progress telemetry for long-running solves.
+ *
+ * This file includes the shared counters solvers publish their progress to,
+ * and function prototypes for a background reporter thread that prints
+ * periodic snapshots of them to stderr or a local Unix socket.
+ * Solvers only do relaxed atomic stores to the counters, so the hot loop
+ * is never blocked by the reporter.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include "def.h"
+
+typedef struct {
+	long long nodes;       // States expanded by tree searches
+	long long moves;       // Queens placed or moved by local searches
+	long long bestThreats; // Lowest threat count reached so far (-1 if none)
+	long long restarts;    // Restarts made
+	long long depth;       // Current stack (search tree) depth
+} Telemetry;
+
+/**
+ * @brief Counters shared between the solver and the reporter thread.
+ */
+extern Telemetry telemetry;
+
+/**
+ * @brief Publishes value into a field of the shared counters.
+ *
+ * A relaxed atomic store, which compiles to a plain store on common targets.
+ */
+#define PUBLISH_PROGRESS(field, value) \
+	__atomic_store_n(&telemetry.field, (long long) (value), __ATOMIC_RELAXED)
+
+/**
+ * @brief Function to start the background progress reporter.
+ *
+ * This function resets the shared counters and starts a thread that
+ * every interval seconds prints a snapshot with the nodes and moves made
+ * (and their rate per second), the best threat count, the restarts,
+ * the stack depth, and the elapsed time versus maxtime.
+ * Snapshots are written to the stream Unix socket at socketPath,
+ * or to stderr if socketPath is null.
+ * If the socket can't be connected or the thread can't be created
+ * EXIT_FAILURE is returned.
+ *
+ * @param  interval   Seconds between snapshots (more than 0)
+ * @param  maxtime    Max time of the solve, shown next to the elapsed time
+ * @param  socketPath Path of a listening Unix socket, or null for stderr
+ * @return            EXIT_FAILURE or EXIT_SUCCESS
+ */
+int startTelemetry(int interval, int maxtime, const char *socketPath);
+
+/**
+ * @brief Function to stop the background progress reporter.
+ *
+ * This function stops the reporter thread, prints a last snapshot
+ * and closes the socket. It does nothing if the reporter isn't running.
+ */
+void stopTelemetry(void);
+
+#endif
@@ -0,0 +1,306 @@
+/**
+ * @file tempering.c
+ * @brief Implements functions of tempering.h file.
+ */
+
+#include "tempering.h"
+#include "telemetry.h"
+#include "trace.h"
+#include "util.h"
+#include <pthread.h>	// for threads and barriers
+
+const double T_MIN = 0.05; // Lowest temperature of the ladder
+const double T_MAX = 0.5; // Highest temperature of the ladder
+
+/**
+ * @brief State of a replica, one queen per row.
+ */
+typedef struct {
+    int *colOf;   // Column of the queen in each row
+    int *cols;    // Queens on each column
+    int *diags;   // Queens on each diagonal (row + col)
+    int *antis;   // Queens on each anti-diagonal (row - col + N - 1)
+    int threats;  // Pairs of queens at threat
+} Replica;
+
+/**
+ * @brief Data shared by the replica threads.
+ */
+typedef struct {
+    int N, maxtime, replicas;
+    Replica *states;          // States (swapped between temperatures)
+    Replica **slots;          // State at each temperature
+    unsigned long long *rngs; // Random number generator of each temperature
+    long long *moves;         // Moves accepted at each temperature
+    TemperingStats *stats;
+    pthread_barrier_t barrier;
+    pthread_mutex_t gateLock;
+    pthread_cond_t gate;
+    int started;              // 0 until all threads are created, then 1, or -1 if one couldn't be
+    struct timespec start;
+    int stop;                 // Set by thread 0 when time expired or solved
+    int solved;               // Set by the thread that finds the solution
+    Point *solution;
+} Tempering;
+
+/**
+ * @brief Thread argument, the shared data and the temperature of the thread.
+ */
+typedef struct {
+    Tempering *shared;
+    int slot;
+} ReplicaThread;
+
+/**
+ * @brief Helper function to place each queen of a replica at a random column.
+ */
+static void randomReplica(Replica *r, int N, unsigned long long *rng) {
+    int i, c;
+
+    memset(r->cols, 0, N * sizeof(int));
+    memset(r->diags, 0, (2 * N - 1) * sizeof(int));
+    memset(r->antis, 0, (2 * N - 1) * sizeof(int));
+    r->threats = 0;
+    for (i = 0; i < N; i++) {
+        c = nextRandom(rng) % N;
+        r->colOf[i] = c;
+        // Each queen threatens the queens already on its lines
+        r->threats += r->cols[c]++ + r->diags[i + c]++ + r->antis[i - c + N - 1]++;
+    }
+}
+
+/**
+ * @brief Helper function to try exchanging the states of two neighbouring temperatures.
+ */
+static void tryExchange(Tempering *t, int i, unsigned long long *rng) {
+    Replica *tmp;
+    double betaDiff = 1 / t->stats->temperatures[i] - 1 / t->stats->temperatures[i + 1];
+    double energyDiff = t->slots[i]->threats - t->slots[i + 1]->threats;
+
+    t->stats->swapAttempts[i]++;
+    // Metropolis swap rule, min(1, e^((Bi - Bj)(Ei - Ej)))
+    if (betaDiff * energyDiff >= 0 || nextUniform(rng) < exp(betaDiff * energyDiff)) {
+        tmp = t->slots[i];
+        t->slots[i] = t->slots[i + 1];
+        t->slots[i + 1] = tmp;
+        t->stats->swapAccepts[i]++;
+    }
+}
+
+/**
+ * @brief Replica thread loop, anneals at its temperature and takes part in exchanges.
+ */
+static void *runReplica(void *arg) {
+    ReplicaThread *self = arg;
+    Tempering *t = self->shared;
+    int N = t->N, slot = self->slot, round = 0, k, i, row, from, to, delta, bestThreats = INT_MAX;
+    double temperature = t->stats->temperatures[slot];
+    // Local copies to avoid false sharing, moves is written back before each exchange
+    unsigned long long rngState = t->rngs[slot], *rng = &rngState;
+    long long moves = t->moves[slot], totalMoves;
+    Replica *r;
+
+    // Wait until all threads exist, as the barrier needs every one of them
+    pthread_mutex_lock(&t->gateLock);
+    while (t->started == 0) {
+        pthread_cond_wait(&t->gate, &t->gateLock);
+    }
+    pthread_mutex_unlock(&t->gateLock);
+    if (t->started < 0) {
+        return NULL;
+    }
+
+    for (;;) {
+        r = t->slots[slot];
+        for (k = 0; k < N && !__atomic_load_n(&t->solved, __ATOMIC_RELAXED); k++) {
+            row = nextRandom(rng) % N;
+            from = r->colOf[row];
+            to = nextRandom(rng) % (N - 1);
+            if (to >= from) {
+                to++; // Skip current column
+            }
+            // Threats gained at the new cell minus threats lost at the old one
+            delta = r->cols[to] + r->diags[row + to] + r->antis[row - to + N - 1]
+                  - (r->cols[from] - 1) - (r->diags[row + from] - 1) - (r->antis[row - from + N - 1] - 1);
+            if (delta > 0 && nextUniform(rng) >= exp(-delta / temperature)) {
+                TRACE_EVENT(TRACE_REJECT, row, r->threats + delta);
+                continue; // Reject move
+            }
+            r->cols[from]--;
+            r->diags[row + from]--;
+            r->antis[row - from + N - 1]--;
+            r->cols[to]++;
+            r->diags[row + to]++;
+            r->antis[row - to + N - 1]++;
+            r->colOf[row] = to;
+            r->threats += delta;
+            moves++;
+            TRACE_EVENT(TRACE_ACCEPT, row, r->threats);
+
+            if (r->threats == 0) {
+                int expected = 0;
+                if (__atomic_compare_exchange_n(&t->solved, &expected, 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                    for (i = 0; i < N; i++) {
+                        t->solution[i].x = i;
+                        t->solution[i].y = r->colOf[i];
+                    }
+                }
+                break;
+            }
+        }
+
+        t->moves[slot] = moves;
+        pthread_barrier_wait(&t->barrier);
+        // Thread 0 checks time and exchanges states while the others wait
+        if (slot == 0) {
+            totalMoves = 0;
+            for (i = 0; i < t->replicas; i++) {
+                totalMoves += t->moves[i];
+                if (t->slots[i]->threats < bestThreats) {
+                    bestThreats = t->slots[i]->threats;
+                }
+            }
+            PUBLISH_PROGRESS(moves, totalMoves);
+            PUBLISH_PROGRESS(bestThreats, bestThreats);
+
+            if (t->solved || secondsSince(&t->start) >= t->maxtime) {
+                t->stop = 1;
+            }
+            else {
+                for (i = round % 2; i + 1 < t->replicas; i += 2) {
+                    tryExchange(t, i, rng);
+                }
+                round++;
+            }
+        }
+        pthread_barrier_wait(&t->barrier);
+        if (t->stop) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+Point *solveTempering(int N, int maxtime, int seed, int replicas, TemperingStats *stats) {
+    if (N <= 0 || replicas < 1 || replicas > MAX_REPLICAS || stats == NULL) {
+        return NULL;
+    }
+
+    memset(stats, 0, sizeof(TemperingStats));
+    stats->replicas = replicas;
+
+    // Geometric temperature ladder from T_MIN to T_MAX
+    int i, j, created;
+    for (i = 0; i < replicas; i++) {
+        stats->temperatures[i] = (replicas == 1) ? T_MIN : T_MIN * pow(T_MAX / T_MIN, (double) i / (replicas - 1));
+    }
+
+    Point *solution = malloc(N * sizeof(Point));
+    if (solution == NULL) {
+        return NULL;
+    }
+    // One queen on a board of 1 has no move to make
+    if (N == 1) {
+        solution[0].x = 0;
+        solution[0].y = 0;
+        return solution;
+    }
+
+    Tempering t;
+    pthread_t threads[MAX_REPLICAS];
+    ReplicaThread args[MAX_REPLICAS];
+    Replica *slots[MAX_REPLICAS];
+    size_t lineCount = (size_t) N + N + 2 * (2 * (size_t) N - 1); // Ints of the counters of a replica
+    int *lines = malloc(replicas * lineCount * sizeof(int));
+
+    t.N = N;
+    t.maxtime = maxtime;
+    t.replicas = replicas;
+    t.states = malloc(replicas * sizeof(Replica));
+    t.slots = slots;
+    t.rngs = malloc(replicas * sizeof(unsigned long long));
+    t.moves = calloc(replicas, sizeof(long long));
+    if (lines == NULL || t.states == NULL || t.rngs == NULL || t.moves == NULL) {
+        free(lines);
+        free(t.states);
+        free(t.rngs);
+        free(t.moves);
+        free(solution);
+        return NULL;
+    }
+    t.stats = stats;
+    t.stop = 0;
+    t.solved = 0;
+    t.solution = solution;
+
+    for (i = 0; i < replicas; i++) {
+        int *base = lines + i * lineCount;
+        t.states[i].colOf = base;
+        t.states[i].cols = base + N;
+        t.states[i].diags = base + 2 * N;
+        t.states[i].antis = base + 2 * N + (2 * N - 1);
+        // Distinct generator for every replica of every seed
+        t.rngs[i] = seedRandom((unsigned long long) seed * MAX_REPLICAS + i);
+        randomReplica(&t.states[i], N, &t.rngs[i]);
+        slots[i] = &t.states[i];
+        // Correct chessboard from the start
+        if (t.states[i].threats == 0 && !t.solved) {
+            t.solved = 1;
+            for (j = 0; j < N; j++) {
+                solution[j].x = j;
+                solution[j].y = t.states[i].colOf[j];
+            }
+        }
+    }
+
+    // A solved start needs no threads
+    if (t.solved) {
+        free(lines);
+        free(t.states);
+        free(t.rngs);
+        free(t.moves);
+        return solution;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t.start);
+    pthread_barrier_init(&t.barrier, NULL, replicas);
+    pthread_mutex_init(&t.gateLock, NULL);
+    pthread_cond_init(&t.gate, NULL);
+    t.started = 0;
+    for (created = 0; created < replicas; created++) {
+        args[created].shared = &t;
+        args[created].slot = created;
+        if (pthread_create(&threads[created], NULL, runReplica, &args[created]) != 0) {
+            break;
+        }
+    }
+    // Threads already created leave at the gate if one couldn't be
+    pthread_mutex_lock(&t.gateLock);
+    t.started = (created == replicas) ? 1 : -1;
+    pthread_cond_broadcast(&t.gate);
+    pthread_mutex_unlock(&t.gateLock);
+    for (i = 0; i < created; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    pthread_barrier_destroy(&t.barrier);
+    pthread_mutex_destroy(&t.gateLock);
+    pthread_cond_destroy(&t.gate);
+
+    stats->secondsSpent = secondsSince(&t.start);
+    for (i = 0; i < replicas; i++) {
+        stats->movesMade += t.moves[i];
+    }
+
+    // Free memory blocks
+    free(lines);
+    free(t.states);
+    free(t.rngs);
+    free(t.moves);
+
+    if (!t.solved || created < replicas) {
+        free(solution);
+        return NULL;
+    }
+    return solution;
+}
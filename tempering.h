@@ -0,0 +1,59 @@
+/**
+ *@file tempering.h
+ *@brief Parallel tempering (replica exchange) annealing for the nQueens problem.
+ *
+ * This file includes the function prototype of a parallel tempering solver
+ * that runs one annealing replica per thread, each at a fixed temperature
+ * of a geometric ladder, and the struct it reports its statistics in.
+ * It uses the struct Point from def.h file.
+ */
+
+#ifndef TEMPERING_H
+#define TEMPERING_H
+#include "def.h"
+
+#define MAX_REPLICAS 64
+
+typedef struct {
+	int replicas;                              // Amount of replicas (threads)
+	double temperatures[MAX_REPLICAS];         // Temperature of each replica, lowest first
+	long long swapAttempts[MAX_REPLICAS - 1];  // Exchanges tried between temperatures i and i+1
+	long long swapAccepts[MAX_REPLICAS - 1];   // Exchanges accepted between temperatures i and i+1
+	long long movesMade;                       // Moves accepted by all replicas
+	double secondsSpent;                       // Wall time spent
+} TemperingStats;
+
+/**
+ * @brief Function that uses parallel tempering to solve the nQueens problem.
+ *
+ * This function runs replicas of simulated annealing at fixed temperatures,
+ * one per thread, and lets neighbouring temperatures exchange their states,
+ * so that states trapped in a local optimum at a low temperature can escape
+ * through a higher one. Each replica keeps one queen per row and counters of
+ * queens on every column and diagonal, so the change in threats of a move is
+ * found in O(1) time, and has its own random number generator seeded from seed.
+ *
+ * The algorithm is the following:
+ * 1. Each replica places each queen in a row, at a random column.
+ * 2. Each replica makes N Metropolis moves at its temperature T:
+ * a. Choose a random queen and a random new column, and find the change Dt in threats.
+ * b. If Dt <= 0, or a random r in [0,1] is less than e^(-Dt/T), move the queen.
+ * c. If the threats are 0 return the positions.
+ * 3. Wait for all replicas. For each pair of neighbouring temperatures (even
+ * pairs and odd pairs in turns) swap their states with probability
+ * min(1, e^((1/Ti - 1/Tj)(Ei - Ej))), Ei being the threats of the state at Ti.
+ * 4. If time hasn't expired go to step 2.
+ *
+ * As the replicas run in parallel, maxtime is measured in wall time.
+ *
+ * @param  N        Amount of queens.
+ * @param  maxtime  Max time to spend running the algorithm.
+ * @param  seed     Seed of the replicas' random number generators.
+ * @param  replicas Amount of replicas (threads), from 1 to MAX_REPLICAS.
+ * @param  stats    Statistics to be filled in and returned.
+ * @return          Returns solution array of points if found, or null if out of time,
+ *                  memory can't be allocated, or the threads couldn't be started
+ */
+Point *solveTempering(int N, int maxtime, int seed, int replicas, TemperingStats *stats);
+
+#endif
@@ -0,0 +1,130 @@
+/**
+ * @file nqclient.c
+ * @brief Client of the solver daemon, sends solve or stats requests.
+ *
+ * Usage:
+ *     nqclient SOCKET stats
+ *     nqclient SOCKET solve N dfs|hill|ann [SEED] [BUDGET_MS] [REPEAT]
+ *
+ * A single solve prints the columns of the queens of rows 0..N-1 on one
+ * line, or the status if not solved. With REPEAT, requests with seeds
+ * SEED..SEED+REPEAT-1 are sent one after the other and a summary of the
+ * statuses and the daemon's latencies is printed instead.
+ */
+
+#include "../daemon.h"
+#include <unistd.h>	// for close
+#include <sys/socket.h>	// for sockets
+#include <sys/un.h>	// for sockaddr_un
+
+const char *STATUS_NAMES[] = {"solved", "no solution", "expired", "rejected"};
+
+/**
+ * @brief Helper function to connect to the daemon and send a request.
+ * @return Returns the connection, or -1 if the daemon can't be reached.
+ */
+static int sendRequest(const char *socketPath, DaemonRequest *request) {
+    struct sockaddr_un address;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd < 0 || strlen(socketPath) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, socketPath);
+    if (connect(fd, (struct sockaddr *) &address, sizeof(address)) != 0
+        || send(fd, request, sizeof(DaemonRequest), 0) != sizeof(DaemonRequest)) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+int main(int argc, char *argv[]) {
+    DaemonRequest request;
+    DaemonReply reply;
+    DaemonStats stats;
+    uint32_t *columns;
+    long long counts[4] = {0}, totalMicros = 0, repeat = 1, r;
+    int fd, i;
+
+    if (argc < 3 || (strcmp(argv[2], "stats") == 0) != (argc == 3)
+        || (strcmp(argv[2], "solve") == 0 && (argc < 5 || argc > 8))) {
+        printf("Usage: %s SOCKET stats | SOCKET solve N dfs|hill|ann [SEED] [BUDGET_MS] [REPEAT]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    memset(&request, 0, sizeof(DaemonRequest));
+    if (strcmp(argv[2], "stats") == 0) {
+        request.type = DAEMON_REQUEST_STATS;
+        if ((fd = sendRequest(argv[1], &request)) < 0
+            || recv(fd, &stats, sizeof(DaemonStats), MSG_WAITALL) != sizeof(DaemonStats)) {
+            printf("Daemon at %s can't be reached! Exiting...\n", argv[1]);
+            return EXIT_FAILURE;
+        }
+        close(fd);
+        printf("Workers: %llu (%llu busy)\n", (unsigned long long) stats.workers, (unsigned long long) stats.busy);
+        printf("Queue depth: %llu\n", (unsigned long long) stats.queueDepth);
+        printf("Served: %llu (%llu expired), rejected: %llu\n", (unsigned long long) stats.served,
+               (unsigned long long) stats.expired, (unsigned long long) stats.rejected);
+        printf("Latency (us): p50 %llu, p90 %llu, p99 %llu, max %llu\n", (unsigned long long) stats.p50,
+               (unsigned long long) stats.p90, (unsigned long long) stats.p99, (unsigned long long) stats.max);
+        return EXIT_SUCCESS;
+    }
+
+    request.type = DAEMON_REQUEST_SOLVE;
+    request.N = strtoul(argv[3], NULL, 10);
+    request.algorithm = (strcmp(argv[4], "dfs") == 0) ? DAEMON_DFS
+                        : (strcmp(argv[4], "hill") == 0) ? DAEMON_HILL
+                        : (strcmp(argv[4], "ann") == 0) ? DAEMON_ANN : DAEMON_ALGORITHMS;
+    request.seed = (argc > 5) ? strtoul(argv[5], NULL, 10) : 0;
+    request.budgetMs = (argc > 6) ? strtoul(argv[6], NULL, 10) : 0;
+    repeat = (argc > 7) ? strtoll(argv[7], NULL, 10) : 1;
+    if (repeat < 1) {
+        printf("Repeat must be a positive integer! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+    columns = malloc((request.N > 0 ? request.N : 1) * sizeof(uint32_t));
+    if (columns == NULL) {
+        printf("Not enough memory for the reply! Exiting...\n");
+        return EXIT_FAILURE;
+    }
+
+    for (r = 0; r < repeat; r++, request.seed++) {
+        if ((fd = sendRequest(argv[1], &request)) < 0
+            || recv(fd, &reply, sizeof(DaemonReply), MSG_WAITALL) != sizeof(DaemonReply)
+            || reply.status < DAEMON_SOLVED || reply.status > DAEMON_REJECTED || reply.N > request.N
+            || recv(fd, columns, reply.N * sizeof(uint32_t), MSG_WAITALL) != (ssize_t) (reply.N * sizeof(uint32_t))) {
+            printf("Daemon at %s can't be reached or replied badly! Exiting...\n", argv[1]);
+            free(columns);
+            return EXIT_FAILURE;
+        }
+        close(fd);
+        counts[reply.status]++;
+        totalMicros += reply.micros;
+    }
+
+    if (repeat == 1) {
+        if (reply.status == DAEMON_SOLVED) {
+            for (i = 0; i < (int) reply.N; i++) {
+                printf(i == 0 ? "%u" : " %u", columns[i]);
+            }
+            printf("\n");
+        }
+        else {
+            printf("%s\n", STATUS_NAMES[reply.status]);
+        }
+        printf("Latency: %u us\n", reply.micros);
+    }
+    else {
+        for (i = 0; i < 4; i++) {
+            printf("%s: %lld\n", STATUS_NAMES[i], counts[i]);
+        }
+        printf("Mean latency: %.1f us\n", (double) totalMicros / repeat);
+    }
+    free(columns);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,211 @@
+/**
+ * @file nqtrace.c
+ * @brief Summarizes or replays a search trace recorded with 'trace FILE'.
+ *
+ * Usage:
+ *     nqtrace FILE [summary|replay]
+ *
+ * summary (the default) prints for every thread the amount of each event,
+ * the deepest DFS state, the acceptance rate of local-search moves, and the
+ * lowest and last threat counts. replay prints every event on its own line,
+ * chunk by chunk, in the order they were written.
+ */
+
+#include "../trace.h"
+
+const char *TYPE_NAMES[TRACE_TYPES] = {"", "push", "pop", "accept", "reject", "restart", "partial"};
+
+/**
+ * @brief Counters of the events of a thread.
+ */
+typedef struct {
+    long long events[TRACE_TYPES];
+    long long maxDepth;
+    long long minThreats, lastThreats;
+    long long firstNanos, lastNanos;
+} ThreadSummary;
+
+/**
+ * @brief Helper function to read an unsigned varint.
+ * @return Returns EXIT_FAILURE if it runs past end or is too long else EXIT_SUCCESS.
+ */
+static int getVarint(const unsigned char **in, const unsigned char *end, unsigned long long *value) {
+    int shift;
+
+    *value = 0;
+    for (shift = 0; *in < end && shift < 64; shift += 7) {
+        *value |= (unsigned long long) (**in & 0x7F) << shift;
+        if ((*(*in)++ & 0x80) == 0) {
+            return EXIT_SUCCESS;
+        }
+    }
+    return EXIT_FAILURE;
+}
+
+/**
+ * @brief Helper function to undo the zigzag mapping of a signed value.
+ */
+static long long unzigzag(unsigned long long value) {
+    return (long long) (value >> 1) ^ -(long long) (value & 1);
+}
+
+/**
+ * @brief Helper function to read a whole file.
+ * @return Returns the contents, or null if it can't be read.
+ */
+static unsigned char *readFile(const char *path, size_t *length) {
+    FILE *fp = fopen(path, "rb");
+    unsigned char *data = NULL, *grown;
+    size_t capacity = 0, got;
+
+    if (fp == NULL) {
+        return NULL;
+    }
+    *length = 0;
+    do {
+        if (*length == capacity) {
+            capacity = capacity ? 2 * capacity : (1 << 20);
+            if ((grown = realloc(data, capacity)) == NULL) {
+                free(data);
+                fclose(fp);
+                return NULL;
+            }
+            data = grown;
+        }
+        got = fread(data + *length, 1, capacity - *length, fp);
+        *length += got;
+    } while (got > 0);
+    fclose(fp);
+
+    return data;
+}
+
+int main(int argc, char *argv[]) {
+    const unsigned char *in, *end, *chunkEnd;
+    unsigned char *data;
+    unsigned long long thread, nanos, length, type, a, b;
+    ThreadSummary *threads = NULL, *t, *grown;
+    long long threadAmount = 0, i, moves;
+    size_t size;
+    int replay, j;
+
+    if (argc < 2 || argc > 3 || (argc == 3 && strcmp(argv[2], "summary") != 0 && strcmp(argv[2], "replay") != 0)) {
+        printf("Usage: %s FILE [summary|replay]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    replay = (argc == 3 && strcmp(argv[2], "replay") == 0);
+
+    data = readFile(argv[1], &size);
+    if (data == NULL || size < 5 || memcmp(data, "NQTR", 4) != 0 || data[4] != TRACE_VERSION) {
+        printf("File %s can't be read or isn't a version %d trace! Exiting...\n", argv[1], TRACE_VERSION);
+        free(data);
+        return EXIT_FAILURE;
+    }
+
+    in = data + 5;
+    end = data + size;
+    while (in < end) {
+        if (getVarint(&in, end, &thread) == EXIT_FAILURE || getVarint(&in, end, &nanos) == EXIT_FAILURE
+            || getVarint(&in, end, &length) == EXIT_FAILURE || length > (unsigned long long) (end - in)
+            || thread > (1 << 20)) {
+            printf("Trace is truncated or corrupt at byte %ld! Exiting...\n", (long) (in - data));
+            free(data);
+            free(threads);
+            return EXIT_FAILURE;
+        }
+        // Threads are numbered in order of their first event
+        if ((long long) thread >= threadAmount) {
+            if ((grown = realloc(threads, (thread + 1) * sizeof(ThreadSummary))) == NULL) {
+                printf("Not enough memory for the summary! Exiting...\n");
+                free(data);
+                free(threads);
+                return EXIT_FAILURE;
+            }
+            threads = grown;
+            for (i = threadAmount; i <= (long long) thread; i++) {
+                memset(&threads[i], 0, sizeof(ThreadSummary));
+                threads[i].minThreats = -1;
+                threads[i].lastThreats = -1;
+                threads[i].firstNanos = -1;
+            }
+            threadAmount = thread + 1;
+        }
+        t = &threads[thread];
+        if (t->firstNanos < 0) {
+            t->firstNanos = nanos;
+        }
+        t->lastNanos = nanos;
+        if (replay) {
+            printf("# thread %llu, chunk at %.6f secs\n", thread, nanos / 1e9);
+        }
+
+        chunkEnd = in + length;
+        while (in < chunkEnd) {
+            if (getVarint(&in, chunkEnd, &type) == EXIT_FAILURE || getVarint(&in, chunkEnd, &a) == EXIT_FAILURE
+                || getVarint(&in, chunkEnd, &b) == EXIT_FAILURE || type == 0 || type >= TRACE_TYPES) {
+                printf("Trace has a corrupt event at byte %ld! Exiting...\n", (long) (in - data));
+                free(data);
+                free(threads);
+                return EXIT_FAILURE;
+            }
+            t->events[type]++;
+            if (type == TRACE_PUSH && unzigzag(a) > t->maxDepth) {
+                t->maxDepth = unzigzag(a);
+            }
+            // All local-search events carry the threat count second
+            if (type >= TRACE_ACCEPT && type != TRACE_REJECT) {
+                t->lastThreats = unzigzag(b);
+                if (t->minThreats < 0 || t->lastThreats < t->minThreats) {
+                    t->minThreats = t->lastThreats;
+                }
+            }
+
+            if (!replay) {
+                continue;
+            }
+            switch (type) {
+                case TRACE_PUSH:
+                    printf("push queens %lld col %lld\n", unzigzag(a), unzigzag(b));
+                    break;
+                case TRACE_POP:
+                    printf("pop queens %lld stack %lld\n", unzigzag(a), unzigzag(b));
+                    break;
+                case TRACE_RESTART:
+                    printf("restart %lld threats %lld\n", unzigzag(a), unzigzag(b));
+                    break;
+                case TRACE_PARTIAL:
+                    printf("partial moved %lld threats %lld\n", unzigzag(a), unzigzag(b));
+                    break;
+                default:
+                    printf("%s row %lld threats %lld\n", TYPE_NAMES[type], unzigzag(a), unzigzag(b));
+                    break;
+            }
+        }
+    }
+
+    if (!replay) {
+        for (i = 0; i < threadAmount; i++) {
+            t = &threads[i];
+            printf("Thread %lld (%.6f to %.6f secs):\n", i, t->firstNanos / 1e9, t->lastNanos / 1e9);
+            for (j = 1; j < TRACE_TYPES; j++) {
+                if (t->events[j] != 0) {
+                    printf("  %-8s %lld\n", TYPE_NAMES[j], t->events[j]);
+                }
+            }
+            if (t->events[TRACE_PUSH] != 0) {
+                printf("  deepest state: %lld queens\n", t->maxDepth);
+            }
+            moves = t->events[TRACE_ACCEPT] + t->events[TRACE_REJECT];
+            if (moves != 0) {
+                printf("  moves accepted: %.1f%%\n", 100.0 * t->events[TRACE_ACCEPT] / moves);
+            }
+            if (t->minThreats >= 0) {
+                printf("  threats: lowest %lld, last %lld\n", t->minThreats, t->lastThreats);
+            }
+        }
+    }
+    free(data);
+    free(threads);
+
+    return EXIT_SUCCESS;
+}
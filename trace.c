@@ -0,0 +1,168 @@
+/**
+ * @file trace.c
+ * @brief Implements functions of trace.h file.
+ */
+
+#include "trace.h"
+#include "util.h"
+#include <pthread.h>	// for mutex
+
+#define TRACE_BUFFER (1 << 16) // Bytes of events buffered per thread
+#define TRACE_EVENT_MAX 30     // Longest event, a type and two 64-bit varints
+
+/**
+ * @brief Event buffer of a thread, all buffers are kept in a list.
+ */
+typedef struct TraceBuffer {
+    int thread;                  // Thread number, in order of first event
+    long long startNanos;        // Time of the first event in the buffer
+    size_t used;
+    unsigned char bytes[TRACE_BUFFER];
+    struct TraceBuffer *next;
+} TraceBuffer;
+
+static pthread_mutex_t traceLock = PTHREAD_MUTEX_INITIALIZER; // Guards the file and the list
+static FILE *traceFile = NULL;
+static int traceFailed = 0;
+static TraceBuffer *buffers = NULL;
+static int threadsSeen = 0;
+static unsigned int generation = 0; // Incremented by every stop, so old buffers aren't reused
+static struct timespec traceStart;
+
+static __thread TraceBuffer *localBuffer = NULL;
+static __thread unsigned int localGeneration = 0;
+
+/**
+ * @brief Helper function to append an unsigned varint.
+ * @return Returns the position after it.
+ */
+static unsigned char *putVarint(unsigned char *out, unsigned long long value) {
+    while (value >= 0x80) {
+        *out++ = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (unsigned char) value;
+    return out;
+}
+
+/**
+ * @brief Helper function to map a signed value to an unsigned one, small magnitudes first.
+ */
+static unsigned long long zigzag(long long value) {
+    return ((unsigned long long) value << 1) ^ (unsigned long long) (value >> 63);
+}
+
+/**
+ * @brief Helper function to get the nanoseconds since the trace started.
+ */
+static long long nanosSinceStart(void) {
+    return nanosSince(&traceStart);
+}
+
+/**
+ * @brief Helper function to write a buffer as a chunk and empty it, with the lock held.
+ */
+static void writeChunk(TraceBuffer *t) {
+    unsigned char header[TRACE_EVENT_MAX], *end = header;
+
+    if (t->used == 0) {
+        return;
+    }
+    end = putVarint(end, t->thread);
+    end = putVarint(end, t->startNanos);
+    end = putVarint(end, t->used);
+    if (fwrite(header, 1, end - header, traceFile) != (size_t) (end - header)
+        || fwrite(t->bytes, 1, t->used, traceFile) != t->used) {
+        traceFailed = 1;
+    }
+    t->used = 0;
+}
+
+/**
+ * @brief Helper function to give the calling thread a buffer in the list.
+ */
+static TraceBuffer *registerBuffer(void) {
+    TraceBuffer *t = malloc(sizeof(TraceBuffer));
+
+    if (t == NULL) {
+        return NULL;
+    }
+    t->used = 0;
+    pthread_mutex_lock(&traceLock);
+    t->thread = threadsSeen++;
+    t->next = buffers;
+    buffers = t;
+    localGeneration = generation;
+    pthread_mutex_unlock(&traceLock);
+    localBuffer = t;
+
+    return t;
+}
+
+int startTrace(const char *path) {
+    FILE *fp;
+
+    if (traceFile != NULL || (fp = fopen(path, "wb")) == NULL) {
+        return EXIT_FAILURE;
+    }
+    fwrite("NQTR", 1, 4, fp);
+    fputc(TRACE_VERSION, fp);
+    traceFailed = 0;
+    threadsSeen = 0;
+    clock_gettime(CLOCK_MONOTONIC, &traceStart);
+    traceFile = fp; // Set last, solver threads start after this returns
+
+    return EXIT_SUCCESS;
+}
+
+void traceEvent(int type, long long a, long long b) {
+    TraceBuffer *t = localBuffer;
+    unsigned char *end;
+
+    if (traceFile == NULL) {
+        return;
+    }
+    if (t == NULL || localGeneration != generation) {
+        if ((t = registerBuffer()) == NULL) {
+            return;
+        }
+    }
+    if (t->used + TRACE_EVENT_MAX > TRACE_BUFFER) {
+        pthread_mutex_lock(&traceLock);
+        writeChunk(t);
+        pthread_mutex_unlock(&traceLock);
+    }
+    if (t->used == 0) {
+        t->startNanos = nanosSinceStart();
+    }
+
+    end = t->bytes + t->used;
+    end = putVarint(end, type);
+    end = putVarint(end, zigzag(a));
+    end = putVarint(end, zigzag(b));
+    t->used = end - t->bytes;
+}
+
+int stopTrace(void) {
+    TraceBuffer *t;
+    int status;
+
+    if (traceFile == NULL) {
+        return EXIT_SUCCESS;
+    }
+
+    pthread_mutex_lock(&traceLock);
+    while (buffers != NULL) {
+        t = buffers;
+        writeChunk(t);
+        buffers = t->next;
+        free(t);
+    }
+    generation++;
+    status = (fclose(traceFile) != 0 || traceFailed) ? EXIT_FAILURE : EXIT_SUCCESS;
+    traceFile = NULL;
+    localBuffer = NULL;
+    pthread_mutex_unlock(&traceLock);
+
+    return status;
+}
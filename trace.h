@@ -0,0 +1,73 @@
+/**
+ *@file trace.h
+ *@brief Optional binary trace of the search steps of the solvers.
+ *
+ * This file includes the event types and function prototypes of a trace
+ * recorder, to see how a slow search went instead of only its final time.
+ * Solvers record events with TRACE_EVENT, which expands to nothing unless
+ * the program is built with TRACE defined ('make TRACE=1'), so the hot
+ * loops cost nothing extra with tracing off.
+ *
+ * Each thread appends events to its own buffer of 64 KiB, which is written
+ * to the trace file as a chunk when full and when the trace stops. The file
+ * starts with the 4 bytes "NQTR" and a version byte, followed by chunks:
+ *
+ *     varint thread, varint nanoseconds since start, varint length, events
+ *
+ * and each event is a varint type followed by its two values as zigzag
+ * varints (7 bits per byte, lowest first, high bit set on all but the last).
+ * tools/nqtrace summarizes or replays a trace.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+#include "def.h"
+
+#define TRACE_VERSION 1
+
+typedef enum {
+	TRACE_PUSH = 1,  // DFS pushed a state: queens placed, column of the last one
+	TRACE_POP,       // DFS popped a state: queens placed, states left on the stack
+	TRACE_ACCEPT,    // Local search kept a move: row moved, threats after it
+	TRACE_REJECT,    // Local search discarded a move: row moved, threats it would give
+	TRACE_RESTART,   // Local search restarted: restarts made, threats of the new start
+	TRACE_PARTIAL,   // Local search partially restarted: queens moved, threats after it
+	TRACE_TYPES
+} TraceType;
+
+#ifdef TRACE
+#define TRACE_EVENT(type, a, b) traceEvent((type), (a), (b))
+#else
+#define TRACE_EVENT(type, a, b) ((void) 0)
+#endif
+
+/**
+ * @brief Function to start recording events to a trace file.
+ *
+ * @param  path Path of the trace file, overwritten if it exists.
+ * @return      EXIT_FAILURE if the file can't be written or a trace is running else EXIT_SUCCESS
+ */
+int startTrace(const char *path);
+
+/**
+ * @brief Function to record an event in the buffer of the calling thread.
+ *
+ * Does nothing if no trace is running. Called through TRACE_EVENT.
+ *
+ * @param  type Event type (TraceType)
+ * @param  a    First value of the event
+ * @param  b    Second value of the event
+ */
+void traceEvent(int type, long long a, long long b);
+
+/**
+ * @brief Function to write the buffers of all threads and close the trace file.
+ *
+ * Threads that recorded events must have finished. Does nothing if no
+ * trace is running.
+ *
+ * @return EXIT_FAILURE if the file couldn't be fully written else EXIT_SUCCESS
+ */
+int stopTrace(void);
+
+#endif
@@ -0,0 +1,53 @@
+/**
+ * @file util.c
+ * @brief Implements functions of util.h file.
+ */
+
+#include "util.h"
+
+unsigned long long seedRandom(unsigned long long seed) {
+    // Odd multiplier maps distinct seeds to distinct states, and only 0 to 0
+    unsigned long long state = (seed + 1) * 0x9E3779B97F4A7C15ULL;
+    return (state != 0) ? state : 1;
+}
+
+unsigned long long nextRandom(unsigned long long *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 2685821657736338717ULL;
+}
+
+double nextUniform(unsigned long long *state) {
+    return (nextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double secondsSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+long long nanosSince(const struct timespec *start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) * 1000000000LL + (now.tv_nsec - start->tv_nsec);
+}
+
+struct timespec deadlineAfter(const struct timespec *start, long long millis) {
+    struct timespec deadline = *start;
+
+    deadline.tv_sec += millis / 1000;
+    deadline.tv_nsec += (millis % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    return deadline;
+}
+
+int isExpired(const struct timespec *deadline) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > deadline->tv_sec || (now.tv_sec == deadline->tv_sec && now.tv_nsec >= deadline->tv_nsec);
+}
@@ -0,0 +1,77 @@
+/**
+ *@file util.h
+ *@brief Helpers shared by the solvers: a random number generator and wall-clock timing.
+ *
+ * This file includes function prototypes for a xorshift64* random number
+ * generator, which solvers running in threads use instead of rand() so that
+ * each thread (or lane, or request) has its own state, and for measuring
+ * wall time and deadlines with the monotonic clock.
+ */
+
+#ifndef UTIL_H
+#define UTIL_H
+#include "def.h"
+
+#define CHECK_STEPS 1024 // Search steps between deadline checks
+
+/**
+ * @brief Function to make the state of a random number generator from a seed.
+ *
+ * Distinct seeds give distinct states, and the state is never 0, which
+ * xorshift can't leave.
+ *
+ * @param  seed Seed of the generator
+ * @return      Returns the state.
+ */
+unsigned long long seedRandom(unsigned long long seed);
+
+/**
+ * @brief Function to draw from a xorshift64* generator.
+ *
+ * @param  state State of the generator, to be modified
+ * @return       Returns a random 64-bit number.
+ */
+unsigned long long nextRandom(unsigned long long *state);
+
+/**
+ * @brief Function to draw a double in [0,1) from a xorshift64* generator.
+ *
+ * @param  state State of the generator, to be modified
+ * @return       Returns a random double.
+ */
+double nextUniform(unsigned long long *state);
+
+/**
+ * @brief Function to get the wall time in seconds since start.
+ *
+ * @param  start Time read from CLOCK_MONOTONIC
+ * @return       Returns the seconds passed.
+ */
+double secondsSince(const struct timespec *start);
+
+/**
+ * @brief Function to get the wall time in nanoseconds since start.
+ *
+ * @param  start Time read from CLOCK_MONOTONIC
+ * @return       Returns the nanoseconds passed.
+ */
+long long nanosSince(const struct timespec *start);
+
+/**
+ * @brief Function to get the time millis milliseconds after start.
+ *
+ * @param  start  Time read from CLOCK_MONOTONIC
+ * @param  millis Milliseconds to add
+ * @return        Returns the deadline.
+ */
+struct timespec deadlineAfter(const struct timespec *start, long long millis);
+
+/**
+ * @brief Function to check if a deadline has passed.
+ *
+ * @param  deadline Time on the CLOCK_MONOTONIC clock
+ * @return          Returns 1 if it has passed else 0.
+ */
+int isExpired(const struct timespec *deadline);
+
+#endif